@@ -22,15 +22,16 @@ ArmDisassembler::ArmDisassembler(const ArmArchitecture *architecture):
         mode_ |= CS_MODE_BIG_ENDIAN;
     }
     capstone_ = std::make_unique<core::arch::Capstone>(CS_ARCH_ARM, mode_);
+    insn_ = capstone_->allocateInstruction();
 }
 
 ArmDisassembler::~ArmDisassembler() {}
 
 std::shared_ptr<core::arch::Instruction> ArmDisassembler::disassembleSingleInstruction(ByteAddr pc, const void *buffer, ByteSize size) {
-    if (auto instr = capstone_->disassemble(pc, buffer, size, 1)) {
+    if (capstone_->disassemble(pc, buffer, size, insn_.get())) {
         /* Instructions must be aligned to their size. */
-        if ((instr->address & (instr->size - 1)) == 0) {
-            return std::make_shared<ArmInstruction>(mode_, instr->address, instr->size, buffer);
+        if ((insn_->address & (insn_->size - 1)) == 0) {
+            return std::make_shared<ArmInstruction>(mode_, insn_->address, insn_->size, buffer, *insn_);
         }
     }
     return nullptr;
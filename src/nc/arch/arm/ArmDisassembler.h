@@ -24,6 +24,7 @@ class ArmArchitecture;
 class ArmDisassembler: public core::arch::Disassembler {
     std::unique_ptr<core::arch::Capstone> capstone_;
     int mode_;
+    core::arch::CapstoneInstructionPtr insn_; ///< Instruction reused for decoding.
 
 public:
     ArmDisassembler(const ArmArchitecture *architecture);
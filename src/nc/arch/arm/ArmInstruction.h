@@ -5,13 +5,80 @@
 
 #include <nc/config.h>
 
+#include <cassert>
+#include <cstddef> /* offsetof */
+#include <cstring>
+#include <memory>
+
 #include <nc/core/arch/CapstoneInstruction.h>
 
 namespace nc {
 namespace arch {
 namespace arm {
 
-typedef core::arch::CapstoneInstruction<CS_ARCH_ARM, 4> ArmInstruction;
+/**
+ * An instruction of ARM platform.
+ *
+ * Keeps Capstone's detail about the instruction computed by the
+ * disassembler, so that the instruction is not decoded again.
+ */
+class ArmInstruction: public core::arch::CapstoneInstruction<CS_ARCH_ARM, 4> {
+    /** Capstone's identifier of the instruction. */
+    unsigned int id_;
+
+    /** Capstone's detail about the instruction, truncated after the last used operand. */
+    std::unique_ptr<char[]> detail_;
+
+public:
+    /**
+     * Constructor.
+     *
+     * \param[in] csMode Encoding mode of this instruction, as denoted in Capstone.
+     * \param[in] addr Instruction address in bytes.
+     * \param[in] size Instruction size in bytes.
+     * \param[in] bytes Valid pointer to the bytes of the instruction.
+     * \param[in] insn Capstone's result of decoding the instruction, with detail.
+     */
+    ArmInstruction(int csMode, ByteAddr addr, SmallByteSize size, const void *bytes, const cs_insn &insn):
+        core::arch::CapstoneInstruction<CS_ARCH_ARM, 4>(csMode, addr, size, bytes), id_(insn.id)
+    {
+        assert(insn.detail != nullptr);
+
+        auto detailSize = detailSizeFor(insn.detail->arm.op_count);
+        detail_.reset(new char[detailSize]);
+        memcpy(detail_.get(), &insn.detail->arm, detailSize);
+    }
+
+    /**
+     * \return Capstone's identifier of the instruction.
+     */
+    unsigned int id() const { return id_; }
+
+    /**
+     * Fills Capstone's detail about the instruction, as Capstone would do.
+     *
+     * \param[out] detail Detail about the instruction.
+     */
+    void getDetail(cs_arm &detail) const {
+        auto op_count = reinterpret_cast<const cs_arm *>(detail_.get())->op_count;
+
+        memset(&detail, 0, sizeof(detail));
+        for (std::size_t i = op_count; i < sizeof(detail.operands) / sizeof(detail.operands[0]); ++i) {
+            detail.operands[i].vector_index = -1;
+        }
+        memcpy(&detail, detail_.get(), detailSizeFor(op_count));
+    }
+
+private:
+    /**
+     * \param opCount Number of operands.
+     *
+     * \return Size of the prefix of cs_arm holding the given number of operands.
+     */
+    static std::size_t detailSizeFor(std::size_t opCount) {
+        return offsetof(cs_arm, operands) + opCount * sizeof(cs_arm_op);
+    }
+};
 
 }}} // namespace nc::arch::arm
 
@@ -53,16 +53,15 @@ NC_DEFINE_REGISTER_EXPRESSION(ArmRegisters, pc)
 class ArmInstructionAnalyzerImpl {
     Q_DECLARE_TR_FUNCTIONS(ArmInstructionAnalyzerImpl)
 
-    core::arch::Capstone capstone_;
     ArmExpressionFactory factory_;
     core::ir::Program *program_;
     const ArmInstruction *instruction_;
-    core::arch::CapstoneInstructionPtr instr_;
+    cs_arm armDetail_;
     const cs_arm *detail_;
 
 public:
     ArmInstructionAnalyzerImpl(const ArmArchitecture *architecture):
-        capstone_(CS_ARCH_ARM, CS_MODE_ARM), factory_(architecture)
+        factory_(architecture), detail_(&armDetail_)
     {}
 
     void createStatements(const ArmInstruction *instruction, core::ir::Program *program) {
@@ -72,9 +71,8 @@ public:
         program_ = program;
         instruction_ = instruction;
 
-        instr_ = disassemble(instruction);
-        assert(instr_ != nullptr);
-        detail_ = &instr_->detail->arm;
+        /* The instruction has already been decoded by the disassembler. */
+        instruction_->getDetail(armDetail_);
 
         auto instructionBasicBlock = program_->getBasicBlockForInstruction(instruction_);
 
@@ -96,11 +94,6 @@ public:
     }
 
 private:
-    core::arch::CapstoneInstructionPtr disassemble(const ArmInstruction *instruction) {
-        capstone_.setMode(instruction->csMode());
-        return capstone_.disassemble(instruction->addr(), instruction->bytes(), instruction->size());
-    }
-
     void createCondition(core::ir::BasicBlock *conditionBasicBlock, core::ir::BasicBlock *bodyBasicBlock, core::ir::BasicBlock *directSuccessor) {
         using namespace core::irgen::expressions;
 
@@ -170,7 +163,7 @@ private:
             pc ^= constant(instruction_->addr() + 2 * instruction_->size())
         ];
 
-        switch (instr_->id) {
+        switch (instruction_->id()) {
         case ARM_INS_ADD: {
             _[operand(0) ^= operand(1) + operand(2)];
             if (!handleWriteToPC(bodyBasicBlock)) {
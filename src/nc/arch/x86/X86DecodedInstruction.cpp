@@ -0,0 +1,74 @@
+/* The file is part of Snowman decompiler. */
+/* See doc/licenses.asciidoc for the licensing information. */
+
+#include "X86DecodedInstruction.h"
+
+#include <cstring> /* memcpy */
+
+namespace nc {
+namespace arch {
+namespace x86 {
+
+static_assert(UD_OP_CONST <= UINT8_MAX, "ud_type values must fit into a byte");
+static_assert(UD_Iextractps <= UINT16_MAX, "mnemonics must fit into 16 bits");
+static_assert(sizeof(ud_operand().lval) <= sizeof(uint64_t), "lval must fit into 64 bits");
+
+X86DecodedInstruction::X86DecodedInstruction(const ud_t &ud):
+    mnemonic_(static_cast<uint16_t>(ud.mnemonic)),
+    operandMode_(ud.opr_mode),
+    addressMode_(ud.adr_mode),
+    repPrefix_(ud.pfx_rep),
+    repePrefix_(ud.pfx_repe),
+    repnePrefix_(ud.pfx_repne)
+{
+    for (std::size_t i = 0; i < MAX_OPERANDS; ++i) {
+        const auto &from = ud.operand[i];
+        auto &to = operands_[i];
+
+        to.lval = 0;
+        memcpy(&to.lval, &from.lval, sizeof(from.lval));
+        to.type = static_cast<uint8_t>(from.type);
+        to.size = from.size;
+        to.base = static_cast<uint8_t>(from.base);
+        to.index = static_cast<uint8_t>(from.index);
+        to.offset = from.offset;
+        to.scale = from.scale;
+    }
+}
+
+ud_operand X86DecodedInstruction::operand(std::size_t index) const {
+    assert(index < MAX_OPERANDS);
+
+    const auto &from = operands_[index];
+
+    ud_operand result;
+    memset(&result, 0, sizeof(result));
+    memcpy(&result.lval, &from.lval, sizeof(result.lval));
+    result.type = static_cast<enum ud_type>(from.type);
+    result.size = from.size;
+    result.base = static_cast<enum ud_type>(from.base);
+    result.index = static_cast<enum ud_type>(from.index);
+    result.offset = from.offset;
+    result.scale = from.scale;
+
+    return result;
+}
+
+void X86DecodedInstruction::restore(ud_t &ud, ByteAddr pc) const {
+    ud.mnemonic = mnemonic();
+    for (std::size_t i = 0; i < MAX_OPERANDS; ++i) {
+        ud.operand[i] = operand(i);
+    }
+    ud.opr_mode = operandMode_;
+    ud.adr_mode = addressMode_;
+    ud.pfx_rep = repPrefix_;
+    ud.pfx_repe = repePrefix_;
+    ud.pfx_repne = repnePrefix_;
+    ud.pc = pc;
+}
+
+} // namespace x86
+} // namespace arch
+} // namespace nc
+
+/* vim:set et sts=4 sw=4: */
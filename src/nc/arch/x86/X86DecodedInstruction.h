@@ -0,0 +1,94 @@
+/* The file is part of Snowman decompiler. */
+/* See doc/licenses.asciidoc for the licensing information. */
+
+#pragma once
+
+#include <nc/config.h>
+
+#include <cassert>
+#include <cstdint>
+
+#include <nc/common/Types.h>
+
+#include "udis86.h"
+
+namespace nc {
+namespace arch {
+namespace x86 {
+
+/**
+ * Compact form of the result of decoding an x86 instruction with udis86.
+ *
+ * Keeps the mnemonic, the operands, the operand and address sizes,
+ * and the repetition prefixes, i.e. everything that the analyses need,
+ * so that an instruction is decoded only once, by the disassembler.
+ */
+class X86DecodedInstruction {
+public:
+    /** Max number of operands. */
+    static const std::size_t MAX_OPERANDS = sizeof(ud_t().operand) / sizeof(ud_t().operand[0]);
+
+private:
+    /** Compact form of an operand. */
+    struct Operand {
+        uint64_t lval; ///< Bytes of the operand's value.
+        uint8_t type; ///< Type of the operand.
+        uint8_t size; ///< Size of the operand.
+        uint8_t base; ///< Base register.
+        uint8_t index; ///< Index register.
+        uint8_t offset; ///< Size of the offset.
+        uint8_t scale; ///< Scale.
+    };
+
+    /** Operands. */
+    Operand operands_[MAX_OPERANDS];
+
+    /** Mnemonic. */
+    uint16_t mnemonic_;
+
+    /** Operand size mode. */
+    uint8_t operandMode_;
+
+    /** Address size mode. */
+    uint8_t addressMode_;
+
+    /** REP, REPE and REPNE prefixes, as stored by udis86. */
+    uint8_t repPrefix_;
+    uint8_t repePrefix_;
+    uint8_t repnePrefix_;
+
+public:
+    /**
+     * Constructor.
+     *
+     * \param ud udis86 object that has just decoded an instruction.
+     */
+    explicit X86DecodedInstruction(const ud_t &ud);
+
+    /**
+     * \return Mnemonic of the instruction.
+     */
+    enum ud_mnemonic_code mnemonic() const { return static_cast<enum ud_mnemonic_code>(mnemonic_); }
+
+    /**
+     * \param index Index of the operand.
+     *
+     * \return The operand in the form used by udis86.
+     */
+    ud_operand operand(std::size_t index) const;
+
+    /**
+     * Puts the decoded instruction into a udis86 object, as if the
+     * object has decoded it. Only the fields stored by this class are set.
+     *
+     * \param[out] ud   udis86 object.
+     * \param[in]  pc   Address of the instruction following the decoded one.
+     */
+    void restore(ud_t &ud, ByteAddr pc) const;
+};
+
+} // namespace x86
+} // namespace arch
+} // namespace nc
+
+/* vim:set et sts=4 sw=4: */
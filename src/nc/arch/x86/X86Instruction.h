@@ -33,6 +33,8 @@
 
 #include <nc/core/arch/Instruction.h>
 
+#include "X86DecodedInstruction.h"
+
 namespace nc {
 namespace arch {
 namespace x86 {
@@ -52,6 +54,9 @@ private:
     /** Copy of architecture's bitness value. */
     uint8_t bitness_;
 
+    /** The instruction as decoded by the disassembler. */
+    X86DecodedInstruction decoded_;
+
 public:
     /**
      * Class constructor.
@@ -60,9 +65,11 @@ public:
      * \param[in] addr Instruction address in bytes.
      * \param[in] size Instruction size in bytes.
      * \param[in] bytes Valid pointer to the bytes of the instruction.
+     * \param[in] decoded The instruction as decoded by the disassembler.
      */
-    X86Instruction(SmallBitSize bitness, ByteAddr addr, SmallByteSize size, const void *bytes):
-        core::arch::Instruction(addr, size), bitness_(checked_cast<uint8_t>(bitness))
+    X86Instruction(SmallBitSize bitness, ByteAddr addr, SmallByteSize size, const void *bytes,
+                   const X86DecodedInstruction &decoded):
+        core::arch::Instruction(addr, size), bitness_(checked_cast<uint8_t>(bitness)), decoded_(decoded)
     {
         assert(size > 0);
         assert(size <= MAX_SIZE);
@@ -75,6 +82,11 @@ public:
      */
     const uint8_t *bytes() const { return &bytes_[0]; }
 
+    /**
+     * \return The instruction as decoded by the disassembler.
+     */
+    const X86DecodedInstruction &decoded() const { return decoded_; }
+
     virtual void print(QTextStream &out) const override;
 };
 
@@ -115,10 +115,6 @@ void X86MasterAnalyzer::detectCallingConventions(core::Context &context) const {
             context.conventions()->setStackArgumentsSize(calleeId, *argumentsSize);
         }
 
-        ud_t ud_obj_;
-        ud_init(&ud_obj_);
-        ud_set_mode(&ud_obj_, context.image()->platform().architecture()->bitness());
-
         foreach (auto function, context.functions()->list()) {
             if (!function->entry()->address()) {
                 continue;
@@ -133,25 +129,23 @@ void X86MasterAnalyzer::detectCallingConventions(core::Context &context) const {
                     continue;
                 }
 
-                ud_set_pc(&ud_obj_, instruction->addr());
-                ud_set_input_buffer(&ud_obj_, const_cast<uint8_t *>(instruction->bytes()),
-                                    checked_cast<std::size_t>(instruction->size()));
-                ud_disassemble(&ud_obj_);
+                const auto &decoded = instruction->decoded();
 
-                assert(ud_obj_.mnemonic != UD_Iinvalid);
+                assert(decoded.mnemonic() != UD_Iinvalid);
 
-                if (ud_obj_.mnemonic != UD_Iret) {
+                if (decoded.mnemonic() != UD_Iret) {
                     continue;
                 }
 
-                if (ud_obj_.operand[0].type == UD_NONE) {
+                auto operand = decoded.operand(0);
+                if (operand.type == UD_NONE) {
                     continue;
                 }
-                assert(ud_obj_.operand[0].type == UD_OP_IMM && ud_obj_.operand[0].size == 16);
+                assert(operand.type == UD_OP_IMM && operand.size == 16);
 
                 CalleeId calleeId(EntryAddress(*function->entry()->address()));
                 context.conventions()->setConvention(calleeId, stdcall32);
-                context.conventions()->setStackArgumentsSize(calleeId, ud_obj_.operand[0].lval.uword);
+                context.conventions()->setStackArgumentsSize(calleeId, operand.lval.uword);
             }
         }
     }
@@ -0,0 +1,132 @@
+/* The file is part of Snowman decompiler. */
+/* See doc/licenses.asciidoc for the licensing information. */
+
+#include "Arena.h"
+
+#include <nc/common/Foreach.h>
+
+#include <algorithm>
+#include <new>
+
+#if defined(_MSC_VER)
+#define NC_THREAD_LOCAL __declspec(thread)
+#else
+#define NC_THREAD_LOCAL __thread
+#endif
+
+namespace nc {
+
+namespace {
+
+/** Alignment of the memory handed out by arenas. */
+union MaxAlign {
+    void *pointer;
+    long long integer;
+    long double floating;
+};
+
+const std::size_t alignment = sizeof(MaxAlign);
+
+/** Limit on the size of a block, unless a single allocation needs more. */
+const std::size_t maxBlockSize = 1024 * 1024;
+
+NC_THREAD_LOCAL Arena *currentArena = nullptr;
+
+/**
+ * Whether the object last destroyed on this thread lived in an arena.
+ * Set by ~ArenaAllocated() and consumed by the operator delete that follows.
+ *
+ * The flag is only meaningful when operator delete directly follows the
+ * destructor. It is stale after the destruction of an object that was not
+ * created by a new-expression (e.g. one on the stack or in a shared_ptr
+ * control block), and it is not set at all when a constructor throws and
+ * the new-expression calls operator delete without a destructor. Therefore,
+ * operator delete checks the current arena first: if a constructor throws,
+ * the arena that the object has been allocated in is still installed.
+ */
+NC_THREAD_LOCAL bool destroyedArenaAllocated = true;
+
+} // anonymous namespace
+
+Arena::Arena(std::size_t initialBlockSize):
+    nextBlockSize_(std::max(initialBlockSize, alignment)), position_(nullptr), available_(0), size_(0), capacity_(0)
+{}
+
+Arena::~Arena() {}
+
+void *Arena::allocate(std::size_t size) {
+    size = (size + alignment - 1) / alignment * alignment;
+
+    if (size > available_) {
+        auto blockSize = std::max(nextBlockSize_, size);
+        blocks_.push_back(Block(std::unique_ptr<char[]>(new char[blockSize]), blockSize));
+
+        position_ = blocks_.back().memory.get();
+        available_ = blockSize;
+        capacity_ += blockSize;
+        nextBlockSize_ = std::min(nextBlockSize_ * 2, maxBlockSize);
+    }
+
+    auto result = position_;
+    position_ += size;
+    available_ -= size;
+    size_ += size;
+
+    return result;
+}
+
+Arena *Arena::current() {
+    return currentArena;
+}
+
+bool Arena::owns(const void *pointer) const {
+    auto address = static_cast<const char *>(pointer);
+
+    reverse_foreach (const auto &block, blocks_) {
+        if (block.memory.get() <= address && address < block.memory.get() + block.size) {
+            return true;
+        }
+    }
+    return false;
+}
+
+Arena::Scope::Scope(Arena *arena):
+    previous_(currentArena)
+{
+    currentArena = arena;
+}
+
+Arena::Scope::~Scope() {
+    currentArena = previous_;
+}
+
+void *ArenaAllocated::operator new(std::size_t size) {
+    if (auto arena = currentArena) {
+        return arena->allocate(size);
+    } else {
+        return ::operator new(size);
+    }
+}
+
+ArenaAllocated::ArenaAllocated():
+    arenaAllocated_(currentArena && currentArena->owns(this))
+{}
+
+ArenaAllocated::~ArenaAllocated() {
+    destroyedArenaAllocated = arenaAllocated_;
+}
+
+void ArenaAllocated::operator delete(void *pointer) {
+    if (currentArena && currentArena->owns(pointer)) {
+        destroyedArenaAllocated = true;
+        return;
+    }
+    if (!destroyedArenaAllocated) {
+        ::operator delete(pointer);
+    }
+    destroyedArenaAllocated = true;
+}
+
+} // namespace nc
+
+/* vim:set et sts=4 sw=4: */
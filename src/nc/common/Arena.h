@@ -0,0 +1,176 @@
+/* The file is part of Snowman decompiler. */
+/* See doc/licenses.asciidoc for the licensing information. */
+
+#pragma once
+
+#include <nc/config.h>
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+namespace nc {
+
+/**
+ * Region-based memory allocator.
+ *
+ * Memory is handed out from contiguous blocks and is released all at once
+ * when the arena is destroyed. The first block is small, and every next
+ * block is twice as large as the previous one (up to a limit), so that
+ * small arenas stay small and large ones need few blocks.
+ *
+ * Objects of classes derived from ArenaAllocated are allocated in
+ * the arena installed for the current thread by Arena::Scope, if any,
+ * and on the heap otherwise.
+ */
+class Arena: boost::noncopyable {
+    /**
+     * Block of memory.
+     */
+    struct Block {
+        std::unique_ptr<char[]> memory; ///< Memory of the block.
+        std::size_t size; ///< Size of the block.
+
+        Block(std::unique_ptr<char[]> memory, std::size_t size):
+            memory(std::move(memory)), size(size)
+        {}
+    };
+
+    std::size_t nextBlockSize_; ///< Size of the next block to be allocated.
+    std::vector<Block> blocks_; ///< Allocated blocks.
+    char *position_; ///< Beginning of the free space in the last block.
+    std::size_t available_; ///< Size of the free space in the last block.
+    std::size_t size_; ///< Total size of the memory handed out.
+    std::size_t capacity_; ///< Total size of the allocated blocks.
+
+public:
+    /**
+     * Constructor.
+     *
+     * \param initialBlockSize Size of the first block of memory, in bytes.
+     */
+    explicit Arena(std::size_t initialBlockSize = 1024);
+
+    /**
+     * Destructor. Frees all the memory allocated by the arena.
+     */
+    ~Arena();
+
+    /**
+     * Allocates memory, suitably aligned for any object of a fundamental type.
+     *
+     * \param size Size of the memory chunk, in bytes.
+     *
+     * \return Valid pointer to the allocated memory.
+     */
+    void *allocate(std::size_t size);
+
+    /**
+     * \return Total size of the memory handed out by the arena, in bytes.
+     */
+    std::size_t size() const { return size_; }
+
+    /**
+     * \return Total size of the blocks allocated by the arena, in bytes.
+     */
+    std::size_t capacity() const { return capacity_; }
+
+    /**
+     * \return Pointer to the arena installed for the current thread. Can be nullptr.
+     */
+    static Arena *current();
+
+    /**
+     * \param pointer Pointer to memory.
+     *
+     * \return True if the memory belongs to one of the blocks of this arena, false otherwise.
+     *
+     * The most recently allocated blocks are checked first, so the check is
+     * fast for the memory that has just been handed out.
+     */
+    bool owns(const void *pointer) const;
+
+    /**
+     * Installs an arena for the current thread for the lifetime of the object.
+     */
+    class Scope: boost::noncopyable {
+        Arena *previous_;
+
+    public:
+        /**
+         * Constructor.
+         *
+         * \param arena Pointer to the arena to be installed. Can be nullptr.
+         */
+        explicit Scope(Arena *arena);
+
+        /**
+         * Destructor. Reinstalls the previously installed arena.
+         */
+        ~Scope();
+    };
+};
+
+/**
+ * Base class for objects allocated in the current thread's arena.
+ *
+ * Deleting such an object runs its destructor, but its memory is
+ * reclaimed only when the arena is destroyed. Therefore, the arena
+ * must outlive all the objects allocated in it.
+ *
+ * Each object remembers whether it lives in an arena. The flag is set
+ * by the constructor, which checks the object's address against the
+ * blocks of the current thread's arena, and is handed over to operator
+ * delete by the destructor through a thread-local variable. Memory owned
+ * by the current thread's arena is never returned to the heap, also when
+ * operator delete is called without a destructor because a constructor
+ * has thrown. Deleting an object thus takes no locks and touches no
+ * global state.
+ *
+ * \note Arena allocation batches the deallocation of IR nodes, not their
+ *       destruction: destructors still run one by one, as the nodes own
+ *       heap memory (strings, jump tables, std::function callbacks, and
+ *       child nodes created on the heap after cloning, e.g. by hooks).
+ *       Destroying a function is linear in the number of its nodes, with
+ *       no per-node deallocation; freeing their memory is linear in the
+ *       number of blocks.
+ */
+class ArenaAllocated {
+    bool arenaAllocated_; ///< True if the object lives in an arena.
+
+public:
+    /**
+     * Constructor.
+     */
+    ArenaAllocated();
+
+    /**
+     * Copy constructor. The copy decides on its own where it lives.
+     */
+    ArenaAllocated(const ArenaAllocated &): ArenaAllocated() {}
+
+    /**
+     * Assignment operator. Keeps the placement of the object.
+     */
+    ArenaAllocated &operator=(const ArenaAllocated &) { return *this; }
+
+    /**
+     * Destructor.
+     */
+    ~ArenaAllocated();
+
+    /**
+     * \return True if the object lives in an arena, false if on the heap or elsewhere.
+     */
+    bool isArenaAllocated() const { return arenaAllocated_; }
+
+    static void *operator new(std::size_t size);
+    static void operator delete(void *pointer);
+};
+
+} // namespace nc
+
+/* vim:set et sts=4 sw=4: */
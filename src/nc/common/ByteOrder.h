@@ -7,6 +7,11 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <stdlib.h> /* _byteswap_* */
+#endif
 
 #include <QSysInfo>
 
@@ -62,6 +67,53 @@ public:
         }
     }
 
+    /**
+     * \param value Integer value.
+     *
+     * \return The value with the order of bytes reversed.
+     */
+    static uint8_t swapBytes(uint8_t value) { return value; }
+
+    /**
+     * \param value Integer value.
+     *
+     * \return The value with the order of bytes reversed.
+     */
+    static uint16_t swapBytes(uint16_t value) {
+        return static_cast<uint16_t>((value << 8) | (value >> 8));
+    }
+
+    /**
+     * \param value Integer value.
+     *
+     * \return The value with the order of bytes reversed.
+     */
+    static uint32_t swapBytes(uint32_t value) {
+#if defined(__GNUC__)
+        return __builtin_bswap32(value);
+#elif defined(_MSC_VER)
+        return _byteswap_ulong(value);
+#else
+        return (value << 24) | ((value & 0xff00) << 8) | ((value >> 8) & 0xff00) | (value >> 24);
+#endif
+    }
+
+    /**
+     * \param value Integer value.
+     *
+     * \return The value with the order of bytes reversed.
+     */
+    static uint64_t swapBytes(uint64_t value) {
+#if defined(__GNUC__)
+        return __builtin_bswap64(value);
+#elif defined(_MSC_VER)
+        return _byteswap_uint64(value);
+#else
+        return (static_cast<uint64_t>(swapBytes(static_cast<uint32_t>(value))) << 32) |
+               swapBytes(static_cast<uint32_t>(value >> 32));
+#endif
+    }
+
     /**
      * Converts the contents of buf from *this byte order to the Current byte order.
      *
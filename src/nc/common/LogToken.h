@@ -27,6 +27,7 @@
 
 #include <cassert>
 #include <memory>
+#include <utility>
 
 #include "Logger.h"
 
@@ -58,6 +59,15 @@ public:
         assert(logger_);
     }
 
+    /**
+     * \param[in] level Log level.
+     *
+     * \return True if messages of the given level are actually logged, false otherwise.
+     */
+    bool isEnabled(LogLevel level) const {
+        return logger_ && level >= logger_->minLevel();
+    }
+
     /**
      * Logs a message with a given level.
      *
@@ -65,38 +75,56 @@ public:
      * \param[in] text  Text of the message.
      */
     void log(LogLevel level, const QString &text) const {
-        if (logger_) {
+        if (isEnabled(level)) {
             logger_->log(level, text);
         }
     }
 
+    /**
+     * Logs a message with a given level. The message is built
+     * only if messages of this level are actually logged.
+     *
+     * \param[in] level   Log level of the message.
+     * \param[in] builder Function returning the text of the message.
+     */
+    template<class Builder, class = decltype(QString(std::declval<Builder &>()()))>
+    void log(LogLevel level, Builder builder) const {
+        if (isEnabled(level)) {
+            logger_->log(level, builder());
+        }
+    }
+
     /**
      * Logs a message with the debug level.
      *
-     * \param[in] text Text of the message.
+     * \param[in] text Text of the message, or a function returning it.
      */
-    void debug(const QString &text) const { log(LogLevel::DEBUG, text); }
+    template<class Text>
+    void debug(Text &&text) const { log(LogLevel::DEBUG, std::forward<Text>(text)); }
 
     /**
      * Logs a message with the info level.
      *
-     * \param[in] text Text of the message.
+     * \param[in] text Text of the message, or a function returning it.
      */
-    void info(const QString &text) const { log(LogLevel::INFO, text); }
+    template<class Text>
+    void info(Text &&text) const { log(LogLevel::INFO, std::forward<Text>(text)); }
 
     /**
      * Logs a message with the warning level.
      *
-     * \param[in] text Text of the message.
+     * \param[in] text Text of the message, or a function returning it.
      */
-    void warning(const QString &text) const { log(LogLevel::WARNING, text); }
+    template<class Text>
+    void warning(Text &&text) const { log(LogLevel::WARNING, std::forward<Text>(text)); }
 
     /**
      * Logs a message with the error level.
      *
-     * \param[in] text Text of the message.
+     * \param[in] text Text of the message, or a function returning it.
      */
-    void error(const QString &text) const { log(LogLevel::ERROR, text); }
+    template<class Text>
+    void error(Text &&text) const { log(LogLevel::ERROR, std::forward<Text>(text)); }
 };
 
 } // namespace nc
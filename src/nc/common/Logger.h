@@ -85,12 +85,28 @@ private:
  * Logger does the actual logging of messages.
  */
 class Logger {
+    /** Minimal level of the messages being logged. */
+    LogLevel minLevel_;
+
 public:
+    /**
+     * Constructor.
+     *
+     * \param minLevel Minimal level of the messages being logged.
+     */
+    Logger(LogLevel minLevel = LogLevel::LOWEST): minLevel_(minLevel) {}
+
     /**
      * Virtual destructor.
      */
     virtual ~Logger() {}
 
+    /**
+     * \return Minimal level of the messages being logged.
+     *         Messages with lower levels are not passed to log().
+     */
+    LogLevel minLevel() const { return minLevel_; }
+
     /**
      * Logs a message with a given level.
      *
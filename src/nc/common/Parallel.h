@@ -0,0 +1,109 @@
+/* The file is part of Snowman decompiler. */
+/* See doc/licenses.asciidoc for the licensing information. */
+
+#pragma once
+
+#include <nc/config.h>
+
+#include <cstddef>
+
+#include "Foreach.h"
+
+#ifdef NC_USE_THREADS
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+#endif
+
+namespace nc {
+
+/**
+ * \return Number of threads that can run truly concurrently on this machine.
+ *         Always positive.
+ */
+inline int idealThreadCount() {
+#ifdef NC_USE_THREADS
+    return std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+#else
+    return 1;
+#endif
+}
+
+/**
+ * Calls a function for every index from [0, size) using at most the given
+ * number of threads, one of which is the calling thread.
+ *
+ * Indices are not assigned to threads up front: each thread takes the
+ * next unprocessed index as soon as it is done with the previous one,
+ * so that a few expensive items do not leave the other threads idle.
+ *
+ * If the function throws, no new indices are handed out, and the first
+ * thrown exception is rethrown in the calling thread after all the
+ * threads have finished.
+ *
+ * When threads are disabled or threadCount <= 1, the function is called
+ * for all indices in increasing order in the calling thread.
+ *
+ * \param size          Number of indices.
+ * \param threadCount   Maximal number of threads to use.
+ * \param function      Function taking an index. Must be safe to call concurrently.
+ */
+template<class Function>
+void parallelFor(std::size_t size, int threadCount, Function function) {
+#ifdef NC_USE_THREADS
+    if (threadCount > 1 && size > 1) {
+        std::atomic<std::size_t> nextIndex(0);
+        std::atomic<bool> failed(false);
+        std::exception_ptr exception;
+        std::mutex exceptionMutex;
+
+        auto work = [&]() {
+            while (!failed) {
+                std::size_t index = nextIndex++;
+                if (index >= size) {
+                    break;
+                }
+                try {
+                    function(index);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(exceptionMutex);
+                    if (!exception) {
+                        exception = std::current_exception();
+                    }
+                    failed = true;
+                }
+            }
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(std::min<std::size_t>(threadCount, size) - 1);
+        while (threads.size() + 1 < std::min<std::size_t>(threadCount, size)) {
+            threads.emplace_back(work);
+        }
+
+        work();
+
+        foreach (auto &thread, threads) {
+            thread.join();
+        }
+
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+        return;
+    }
+#else
+    (void)threadCount;
+#endif
+
+    for (std::size_t index = 0; index < size; ++index) {
+        function(index);
+    }
+}
+
+} // namespace nc
+
+/* vim:set et sts=4 sw=4: */
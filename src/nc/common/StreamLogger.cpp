@@ -8,6 +8,7 @@
 namespace nc {
 
 void StreamLogger::log(LogLevel level, const QString &text) {
+    std::lock_guard<std::mutex> lock(mutex_);
     stream_ << tr("[%1] %2").arg(level.getName()).arg(text) << endl;
 }
 
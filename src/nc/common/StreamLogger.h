@@ -5,6 +5,8 @@
 
 #include <nc/config.h>
 
+#include <mutex>
+
 #include <QCoreApplication>
 #include <QTextStream>
 
@@ -19,6 +21,7 @@ class StreamLogger: public nc::Logger {
     Q_DECLARE_TR_FUNCTIONS(StreamLogger)
 
     QTextStream &stream_;
+    std::mutex mutex_;
 
 public:
     /**
@@ -28,6 +31,14 @@ public:
      */
     StreamLogger(QTextStream &stream): stream_(stream) {}
 
+    /**
+     * Constructor.
+     *
+     * \param stream Reference to the stream to print messages to.
+     * \param minLevel Minimal level of the messages being printed.
+     */
+    StreamLogger(QTextStream &stream, LogLevel minLevel): Logger(minLevel), stream_(stream) {}
+
     void log(LogLevel level, const QString &text) override;
 };
 
@@ -25,10 +25,12 @@
 #include "Context.h"
 
 #include <nc/common/Foreach.h>
+#include <nc/common/make_unique.h>
 
 #include <nc/core/arch/Architecture.h>
 #include <nc/core/arch/Instructions.h>
 #include <nc/core/image/Image.h>
+#include <nc/core/ir/AnalysisCache.h>
 #include <nc/core/ir/Functions.h>
 #include <nc/core/ir/Program.h>
 #include <nc/core/ir/calling/Conventions.h>
@@ -41,16 +43,23 @@
 #include <nc/core/ir/vars/Variables.h>
 #include <nc/core/likec/Tree.h>
 
+#include "Statistics.h"
+
 namespace nc {
 namespace core {
 
 Context::Context():
     image_(std::make_shared<image::Image>()),
-    instructions_(std::make_shared<arch::Instructions>())
+    instructions_(std::make_shared<arch::Instructions>()),
+    threadCount_(1)
 {}
 
 Context::~Context() {}
 
+void Context::setStatistics(std::unique_ptr<Statistics> statistics) {
+    statistics_ = std::move(statistics);
+}
+
 void Context::setImage(const std::shared_ptr<image::Image> &image) {
     image_ = image;
 }
@@ -65,7 +74,12 @@ void Context::setProgram(std::unique_ptr<ir::Program> program) {
 }
 
 void Context::setFunctions(std::unique_ptr<ir::Functions> functions) {
+    /* The cache refers to the old functions, so it goes first. */
+    analysisCache_.reset();
     functions_ = std::move(functions);
+    if (functions_) {
+        analysisCache_ = std::make_unique<ir::AnalysisCache>();
+    }
 }
 
 void Context::setConventions(std::unique_ptr<ir::calling::Conventions> conventions) {
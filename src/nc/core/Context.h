@@ -44,6 +44,7 @@ namespace image {
 }
 
 namespace ir {
+    class AnalysisCache;
     class Function;
     class Functions;
     class Program;
@@ -74,6 +75,8 @@ namespace likec {
     class Tree;
 }
 
+class Statistics;
+
 /**
  * This class stores all the information that is required and produced during decompilation.
  */
@@ -84,6 +87,7 @@ class Context: public QObject {
     std::shared_ptr<const arch::Instructions> instructions_; ///< Instructions being decompiled.
     std::unique_ptr<ir::Program> program_; ///< Program.
     std::unique_ptr<ir::Functions> functions_; ///< Functions.
+    std::unique_ptr<ir::AnalysisCache> analysisCache_; ///< Cached per-function analyses.
     std::unique_ptr<ir::calling::Conventions> conventions_; ///< Assigned calling conventions.
     std::unique_ptr<ir::calling::Hooks> hooks_; ///< Hooks manager.
     std::unique_ptr<ir::calling::Signatures> signatures_; ///< Signatures.
@@ -95,6 +99,8 @@ class Context: public QObject {
     std::unique_ptr<likec::Tree> tree_; ///< Abstract syntax tree of the LikeC program.
     LogToken logToken_; ///< Log token.
     CancellationToken cancellationToken_; ///< Cancellation token.
+    int threadCount_; ///< Maximal number of threads used by per-function analyses.
+    std::unique_ptr<Statistics> statistics_; ///< Time and memory measurements.
 
 public:
     /**
@@ -144,7 +150,8 @@ public:
     const ir::Program *program() const { return program_.get(); }
 
     /**
-     * Sets the set of functions.
+     * Sets the set of functions and creates an empty cache of per-function
+     * analyses for them (or destroys the cache if functions is nullptr).
      *
      * \param functions Pointer to the set of functions. Can be nullptr.
      */
@@ -155,6 +162,12 @@ public:
      */
     ir::Functions *functions() const { return functions_.get(); }
 
+    /**
+     * \return Pointer to the cache of per-function analyses.
+     *         Valid pointer if functions() is not nullptr, nullptr otherwise.
+     */
+    ir::AnalysisCache *analysisCache() const { return analysisCache_.get(); }
+
     /**
      * Sets the assigned calling conventions.
      *
@@ -317,6 +330,30 @@ public:
      */
     const LogToken &logToken() const { return logToken_; }
 
+    /**
+     * Sets the maximal number of threads that per-function analyses may use.
+     *
+     * \param count Number of threads. Values less than 2 mean serial analysis.
+     */
+    void setThreadCount(int count) { threadCount_ = count; }
+
+    /**
+     * \return Maximal number of threads that per-function analyses may use.
+     */
+    int threadCount() const { return threadCount_; }
+
+    /**
+     * Sets the object collecting time and memory measurements of the decompilation stages.
+     *
+     * \param statistics Pointer to the statistics. Can be nullptr, which disables the measurements.
+     */
+    void setStatistics(std::unique_ptr<Statistics> statistics);
+
+    /**
+     * \return Pointer to the object collecting time and memory measurements. Can be nullptr.
+     */
+    Statistics *statistics() const { return statistics_.get(); }
+
     Q_SIGNALS:
 
     /**
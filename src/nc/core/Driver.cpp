@@ -17,9 +17,11 @@
 #include <nc/core/input/ParserRepository.h>
 #include <nc/core/ir/Function.h>
 #include <nc/core/ir/Functions.h>
+#include <nc/core/irgen/RecursiveDisassembler.h>
 
 #include "Context.h"
 #include "MasterAnalyzer.h"
+#include "Statistics.h"
 
 namespace nc {
 namespace core {
@@ -50,6 +52,8 @@ void Driver::parse(Context &context, const QString &filename) {
 
     context.logToken().info(tr("Parsing using %1 parser...").arg(suitableParser->name()));
 
+    Statistics::Stage stage(context.statistics(), QLatin1String("parse"));
+
     suitableParser->parse(&source, context.image().get(), context.logToken());
 
     context.logToken().info(tr("Parsing completed."));
@@ -78,16 +82,42 @@ void Driver::disassemble(Context &context, const image::ByteSource *source, Byte
 
     context.logToken().info(tr("Disassemble addresses from %2 to %3...").arg(begin, 0, 16).arg(end, 0, 16));
 
+    Statistics::Stage stage(context.statistics(), QLatin1String("disassemble"));
+
     try {
         auto newInstructions = std::make_shared<arch::Instructions>(*context.instructions());
 
-        context.image()->platform().architecture()->createDisassembler()->disassemble(
+        context.image()->platform().architecture()->createDisassembler()->disassembleInParallel(
             context.image().get(),
             source,
             begin,
             end,
             [&](std::shared_ptr<arch::Instruction> instr){ newInstructions->add(std::move(instr)); },
-            context.cancellationToken());
+            context.cancellationToken(),
+            context.threadCount());
+
+        stage.setCounter(QLatin1String("instructions"), newInstructions->size() - context.instructions()->size());
+
+        context.setInstructions(newInstructions);
+
+        context.logToken().info(tr("Disassembly completed."));
+    } catch (const CancellationException &) {
+        context.logToken().info(tr("Disassembly canceled."));
+    }
+}
+
+void Driver::disassembleReachable(Context &context) {
+    context.logToken().info(tr("Disassemble code reachable from the entry point and symbols..."));
+
+    Statistics::Stage stage(context.statistics(), QLatin1String("disassembleReachable"));
+
+    try {
+        auto newInstructions = std::make_shared<arch::Instructions>(*context.instructions());
+
+        irgen::RecursiveDisassembler disassembler(context.image().get(), context.cancellationToken(), context.logToken());
+        disassembler.disassemble(disassembler.getEntryAddresses(), *newInstructions);
+
+        stage.setCounter(QLatin1String("instructions"), newInstructions->size() - context.instructions()->size());
 
         context.setInstructions(newInstructions);
 
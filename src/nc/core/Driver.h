@@ -59,6 +59,14 @@ public:
      */
     static void disassemble(Context &context, const image::ByteSource *source, ByteAddr begin, ByteAddr end);
 
+    /**
+     * Disassembles the code reachable from the entry point, function symbols,
+     * and relocation targets, following direct jumps and calls, and jump tables.
+     *
+     * \param context Context.
+     */
+    static void disassembleReachable(Context &context);
+
     /**
      * Performs decompilation by running all the necessary
      * analyses in the given context in the right order.
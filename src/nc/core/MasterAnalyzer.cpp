@@ -25,13 +25,15 @@
 #include "MasterAnalyzer.h"
 
 #include <nc/common/Foreach.h>
+#include <nc/common/Parallel.h>
 #include <nc/common/make_unique.h>
 
 #include <nc/core/Context.h>
+#include <nc/core/Statistics.h>
 #include <nc/core/arch/Architecture.h>
 #include <nc/core/image/Image.h>
+#include <nc/core/ir/AnalysisCache.h>
 #include <nc/core/ir/BasicBlock.h>
-#include <nc/core/ir/CFG.h>
 #include <nc/core/ir/Function.h>
 #include <nc/core/ir/Functions.h>
 #include <nc/core/ir/FunctionsGenerator.h>
@@ -111,30 +113,51 @@ void MasterAnalyzer::dataflowAnalysis(Context &context) const {
 
     context.setDataflows(std::make_unique<ir::dflow::Dataflows>());
 
-    foreach (auto function, context.functions()->list()) {
-        dataflowAnalysis(context, function);
+    std::vector<ir::Function *> functions(context.functions()->list().begin(), context.functions()->list().end());
+    std::vector<std::unique_ptr<ir::dflow::Dataflow>> dataflows(functions.size());
+
+    parallelFor(functions.size(), context.threadCount(), [&](std::size_t index) {
+        dataflows[index] = computeDataflow(context, functions[index]);
         context.cancellationToken().poll();
+    });
+
+    for (std::size_t index = 0; index < functions.size(); ++index) {
+        context.dataflows()->emplace(functions[index], std::move(dataflows[index]));
     }
 }
 
 void MasterAnalyzer::dataflowAnalysis(Context &context, ir::Function *function) const {
-    context.logToken().info(tr("Dataflow analysis of %1.").arg(getFunctionName(context, function)));
+    context.dataflows()->emplace(function, computeDataflow(context, function));
+}
+
+std::unique_ptr<ir::dflow::Dataflow> MasterAnalyzer::computeDataflow(Context &context, ir::Function *function) const {
+    context.logToken().info([&]() { return tr("Dataflow analysis of %1.").arg(getFunctionName(context, function)); });
+
+    auto statistics = context.statistics();
+    Statistics::Function measurement(statistics, statistics ? getFunctionName(context, function) : QString());
 
     std::unique_ptr<ir::dflow::Dataflow> dataflow(new ir::dflow::Dataflow());
 
+    context.analysisCache()->invalidate(function);
     context.hooks()->instrument(function, dataflow.get());
 
-    ir::dflow::DataflowAnalyzer(*dataflow, context.image()->platform().architecture(), context.cancellationToken(),
-                                context.logToken()).analyze(ir::CFG(function->basicBlocks()));
+    ir::dflow::DataflowAnalyzer analyzer(*dataflow, context.image()->platform().architecture(), context.cancellationToken(),
+                                         context.logToken());
+    analyzer.analyze(context.analysisCache()->getCFG(function));
+
+    measurement.setCounter(QLatin1String("statements"), function->statementCount());
+    measurement.setCounter(QLatin1String("terms"), function->termCount());
+    measurement.setCounter(QLatin1String("iterations"), analyzer.iterationCount());
+    measurement.setCounter(QLatin1String("blockExecutions"), analyzer.blockExecutionCount());
 
-    context.dataflows()->emplace(function, std::move(dataflow));
+    return dataflow;
 }
 
 void MasterAnalyzer::reconstructSignatures(Context &context) const {
     context.logToken().info(tr("Reconstructing function signatures."));
 
     ir::calling::SignatureAnalyzer(*context.signatures(), *context.dataflows(), *context.hooks(),
-        *context.livenesses(), context.cancellationToken(), context.logToken())
+        *context.livenesses(), *context.analysisCache(), context.cancellationToken(), context.logToken())
         .analyze();
 }
 
@@ -160,7 +183,10 @@ void MasterAnalyzer::livenessAnalysis(Context &context) const {
 }
 
 void MasterAnalyzer::livenessAnalysis(Context &context, const ir::Function *function) const {
-    context.logToken().info(tr("Liveness analysis of %1.").arg(getFunctionName(context, function)));
+    context.logToken().info([&]() { return tr("Liveness analysis of %1.").arg(getFunctionName(context, function)); });
+
+    auto statistics = context.statistics();
+    Statistics::Function measurement(statistics, statistics ? getFunctionName(context, function) : QString());
 
     std::unique_ptr<ir::liveness::Liveness> liveness(new ir::liveness::Liveness());
 
@@ -199,7 +225,10 @@ void MasterAnalyzer::structuralAnalysis(Context &context) const {
 }
 
 void MasterAnalyzer::structuralAnalysis(Context &context, const ir::Function *function) const {
-    context.logToken().info(tr("Structural analysis of %1.").arg(getFunctionName(context, function)));
+    context.logToken().info([&]() { return tr("Structural analysis of %1.").arg(getFunctionName(context, function)); });
+
+    auto statistics = context.statistics();
+    Statistics::Function measurement(statistics, statistics ? getFunctionName(context, function) : QString());
 
     std::unique_ptr<ir::cflow::Graph> graph(new ir::cflow::Graph());
 
@@ -216,7 +245,7 @@ void MasterAnalyzer::generateTree(Context &context) const {
 
     ir::cgen::CodeGenerator(*tree, *context.image(), *context.functions(), *context.hooks(),
         *context.signatures(), *context.dataflows(), *context.variables(), *context.graphs(),
-        *context.livenesses(), *context.types(), context.cancellationToken())
+        *context.livenesses(), *context.types(), *context.analysisCache(), context.cancellationToken())
         .makeCompilationUnit();
 
     context.setTree(std::move(tree));
@@ -225,43 +254,98 @@ void MasterAnalyzer::generateTree(Context &context) const {
 void MasterAnalyzer::decompile(Context &context) const {
     context.logToken().info(tr("Decompiling."));
 
-    createProgram(context);
+    auto statistics = context.statistics();
+
+    {
+        Statistics::Stage stage(statistics, QLatin1String("createProgram"));
+        createProgram(context);
+        stage.setCounter(QLatin1String("basicBlocks"), context.program()->basicBlocks().size());
+    }
     context.cancellationToken().poll();
 
-    createFunctions(context);
+    {
+        Statistics::Stage stage(statistics, QLatin1String("createFunctions"));
+        createFunctions(context);
+
+        if (statistics) {
+            std::int64_t statements = 0, terms = 0, arenaSize = 0;
+            foreach (const ir::Function *function, context.functions()->list()) {
+                statements += function->statementCount();
+                terms += function->termCount();
+                arenaSize += function->arena().size();
+            }
+            stage.setCounter(QLatin1String("functions"), context.functions()->list().size());
+            stage.setCounter(QLatin1String("statements"), statements);
+            stage.setCounter(QLatin1String("terms"), terms);
+            stage.setCounter(QLatin1String("arenaSize"), arenaSize);
+        }
+    }
     context.cancellationToken().poll();
 
-    createHooks(context);
+    {
+        Statistics::Stage stage(statistics, QLatin1String("createHooks"));
+        createHooks(context);
+    }
     context.cancellationToken().poll();
 
-    detectCallingConventions(context);
+    {
+        Statistics::Stage stage(statistics, QLatin1String("detectCallingConventions"));
+        detectCallingConventions(context);
+    }
     context.cancellationToken().poll();
 
-    dataflowAnalysis(context);
+    {
+        Statistics::Stage stage(statistics, QLatin1String("dataflowAnalysis"));
+        dataflowAnalysis(context);
+    }
     context.cancellationToken().poll();
 
-    livenessAnalysis(context);
+    {
+        Statistics::Stage stage(statistics, QLatin1String("livenessAnalysis"));
+        livenessAnalysis(context);
+    }
     context.cancellationToken().poll();
 
-    reconstructSignatures(context);
+    {
+        Statistics::Stage stage(statistics, QLatin1String("reconstructSignatures"));
+        reconstructSignatures(context);
+    }
     context.cancellationToken().poll();
 
-    dataflowAnalysis(context);
+    {
+        Statistics::Stage stage(statistics, QLatin1String("dataflowAnalysis"));
+        dataflowAnalysis(context);
+    }
     context.cancellationToken().poll();
 
-    reconstructVariables(context);
+    {
+        Statistics::Stage stage(statistics, QLatin1String("reconstructVariables"));
+        reconstructVariables(context);
+    }
     context.cancellationToken().poll();
 
-    structuralAnalysis(context);
+    {
+        Statistics::Stage stage(statistics, QLatin1String("structuralAnalysis"));
+        structuralAnalysis(context);
+    }
     context.cancellationToken().poll();
 
-    livenessAnalysis(context);
+    {
+        Statistics::Stage stage(statistics, QLatin1String("livenessAnalysis"));
+        livenessAnalysis(context);
+    }
     context.cancellationToken().poll();
 
-    reconstructTypes(context);
+    {
+        Statistics::Stage stage(statistics, QLatin1String("reconstructTypes"));
+        reconstructTypes(context);
+    }
     context.cancellationToken().poll();
 
-    generateTree(context);
+    {
+        Statistics::Stage stage(statistics, QLatin1String("generateTree"));
+        generateTree(context);
+    }
     context.cancellationToken().poll();
 
     context.logToken().info(tr("Decompilation completed."));
@@ -25,6 +25,8 @@
 
 #include <nc/config.h>
 
+#include <memory>
+
 #include <QCoreApplication> /* For Q_DECLARE_TR_FUNCTIONS. */
 
 namespace nc {
@@ -36,6 +38,9 @@ namespace ir {
     namespace calling {
         class CalleeId;
     }
+    namespace dflow {
+        class Dataflow;
+    }
 }
 
 class Context;
@@ -48,8 +53,9 @@ class Context;
  * and register it by calling Architecture::setMasterAnalyzer().
  * 
  * Methods of this class can be executed concurrently.
- * (Though, only on different context currently.)
- * Therefore, they all are const.
+ * (Though, only on different context currently, except for
+ * computeDataflow(), which can also be called for different functions
+ * of the same context.) Therefore, they all are const.
  */
 class MasterAnalyzer {
     Q_DECLARE_TR_FUNCTIONS(MasterAnalyzer)
@@ -94,6 +100,10 @@ public:
     /**
      * Performs dataflow analysis of all functions.
      *
+     * Functions are analyzed using up to context.threadCount() threads.
+     * The results are stored in the context in the order of functions,
+     * so they do not depend on the number of threads.
+     *
      * \param context Context.
      */
     virtual void dataflowAnalysis(Context &context) const;
@@ -106,6 +116,18 @@ public:
      */
     virtual void dataflowAnalysis(Context &context, ir::Function *function) const;
 
+    /**
+     * Instruments the given function and computes its dataflow information.
+     * Does not modify the context, except for the hooks and the analysis cache,
+     * and can be called for different functions concurrently.
+     *
+     * \param context Context.
+     * \param function Valid pointer to the function.
+     *
+     * \return Valid pointer to the dataflow information of the function.
+     */
+    virtual std::unique_ptr<ir::dflow::Dataflow> computeDataflow(Context &context, ir::Function *function) const;
+
     /**
      * Reconstructs signatures of functions.
      *
@@ -0,0 +1,322 @@
+/* The file is part of Snowman decompiler. */
+/* See doc/licenses.asciidoc for the licensing information. */
+
+#include "Statistics.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include <QTextStream>
+
+#include <nc/common/Foreach.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#ifdef _MSC_VER
+#pragma comment(lib, "psapi.lib")
+#endif
+#else
+#include <cstdio>
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+namespace nc {
+namespace core {
+
+namespace {
+
+#if defined(_WIN32)
+double toSeconds(const FILETIME &time) {
+    ULARGE_INTEGER value;
+    value.LowPart = time.dwLowDateTime;
+    value.HighPart = time.dwHighDateTime;
+    return value.QuadPart * 1e-7;
+}
+#endif
+
+double currentTime() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+QString toJson(const QString &string) {
+    QString result;
+    result.reserve(string.size() + 2);
+
+    result += '"';
+    foreach (QChar c, string) {
+        if (c == '"' || c == '\\') {
+            result += '\\';
+            result += c;
+        } else if (c.unicode() < 0x20) {
+            result += QString("\\u%1").arg(c.unicode(), 4, 16, QChar('0'));
+        } else {
+            result += c;
+        }
+    }
+    result += '"';
+
+    return result;
+}
+
+QString toJson(double value) {
+    return QString::number(value, 'f', 6);
+}
+
+void printCounters(QTextStream &out, const Statistics::Counters &counters) {
+    out << "{";
+    bool first = true;
+    foreach (const auto &counter, counters) {
+        if (!first) {
+            out << ", ";
+        }
+        first = false;
+        out << toJson(counter.first) << ": " << static_cast<qlonglong>(counter.second);
+    }
+    out << "}";
+}
+
+} // anonymous namespace
+
+Statistics::Usage Statistics::Usage::now() {
+    Usage result;
+
+    result.wallTime = currentTime();
+    result.cpuTime = 0;
+    result.memory = 0;
+    result.peakMemory = 0;
+
+#if defined(_WIN32)
+    FILETIME creationTime, exitTime, kernelTime, userTime;
+    if (GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime)) {
+        result.cpuTime = toSeconds(kernelTime) + toSeconds(userTime);
+    }
+
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        result.memory = counters.WorkingSetSize;
+        result.peakMemory = counters.PeakWorkingSetSize;
+    }
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        result.cpuTime = usage.ru_utime.tv_sec + usage.ru_utime.tv_usec * 1e-6 +
+                         usage.ru_stime.tv_sec + usage.ru_stime.tv_usec * 1e-6;
+#ifdef __APPLE__
+        result.peakMemory = usage.ru_maxrss;
+#else
+        result.peakMemory = static_cast<std::size_t>(usage.ru_maxrss) * 1024;
+#endif
+    }
+
+#ifdef __linux__
+    if (FILE *statm = fopen("/proc/self/statm", "r")) {
+        unsigned long size, resident;
+        if (fscanf(statm, "%lu %lu", &size, &resident) == 2) {
+            result.memory = static_cast<std::size_t>(resident) * sysconf(_SC_PAGESIZE);
+        }
+        fclose(statm);
+    }
+#endif
+#endif
+
+    return result;
+}
+
+Statistics::Stage::Stage(Statistics *statistics, const QString &name):
+    statistics_(statistics), index_(0)
+{
+    if (statistics_) {
+        start_ = Usage::now();
+        index_ = statistics_->beginStage(name, start_);
+    }
+}
+
+Statistics::Stage::~Stage() {
+    if (statistics_) {
+        statistics_->endStage(index_, Usage::now(), std::move(counters_));
+    }
+}
+
+Statistics::Function::Function(Statistics *statistics, QString name):
+    statistics_(statistics), name_(std::move(name)), start_(0)
+{
+    if (statistics_) {
+        start_ = currentTime();
+    }
+}
+
+Statistics::Function::~Function() {
+    if (statistics_) {
+        FunctionRecord record;
+        record.name = std::move(name_);
+        record.start = start_;
+        record.wallTime = currentTime() - start_;
+        record.counters = std::move(counters_);
+
+        statistics_->addFunction(std::move(record));
+    }
+}
+
+Statistics::Statistics():
+    start_(Usage::now())
+{}
+
+Statistics::~Statistics() {}
+
+std::size_t Statistics::beginStage(const QString &name, const Usage &start) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    StageRecord record;
+    record.name = name;
+    record.pass = 1;
+    record.finished = false;
+    record.thread = getThreadNumber();
+    record.start = start;
+    record.finish = start;
+
+    foreach (const auto &stage, stages_) {
+        if (stage.name == name) {
+            ++record.pass;
+        }
+    }
+
+    stages_.push_back(std::move(record));
+    openStages_.push_back(stages_.size() - 1);
+
+    return stages_.size() - 1;
+}
+
+void Statistics::endStage(std::size_t index, const Usage &finish, Counters counters) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    assert(index < stages_.size());
+
+    auto &stage = stages_[index];
+    stage.finished = true;
+    stage.finish = finish;
+    stage.counters = std::move(counters);
+
+    openStages_.erase(std::remove(openStages_.begin(), openStages_.end(), index), openStages_.end());
+}
+
+void Statistics::addFunction(FunctionRecord record) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    record.thread = getThreadNumber();
+
+    if (!openStages_.empty()) {
+        stages_[openStages_.back()].functions.push_back(std::move(record));
+    }
+}
+
+int Statistics::getThreadNumber() {
+    return threads_.insert(std::make_pair(std::this_thread::get_id(), static_cast<int>(threads_.size()) + 1)).first->second;
+}
+
+void Statistics::print(QTextStream &out) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto now = Usage::now();
+
+    out << "{" << endl;
+    out << "  \"wallTime\": " << toJson(now.wallTime - start_.wallTime) << "," << endl;
+    out << "  \"cpuTime\": " << toJson(now.cpuTime - start_.cpuTime) << "," << endl;
+    out << "  \"peakMemory\": " << static_cast<qulonglong>(now.peakMemory) << "," << endl;
+    out << "  \"stages\": [";
+
+    bool firstStage = true;
+    foreach (const auto &stage, stages_) {
+        const auto &finish = stage.finished ? stage.finish : now;
+
+        out << (firstStage ? "" : ",") << endl;
+        firstStage = false;
+
+        out << "    {" << endl;
+        out << "      \"name\": " << toJson(stage.name) << "," << endl;
+        out << "      \"pass\": " << stage.pass << "," << endl;
+        out << "      \"wallTime\": " << toJson(finish.wallTime - stage.start.wallTime) << "," << endl;
+        out << "      \"cpuTime\": " << toJson(finish.cpuTime - stage.start.cpuTime) << "," << endl;
+        out << "      \"memoryBefore\": " << static_cast<qulonglong>(stage.start.memory) << "," << endl;
+        out << "      \"memoryAfter\": " << static_cast<qulonglong>(finish.memory) << "," << endl;
+        out << "      \"peakMemory\": " << static_cast<qulonglong>(finish.peakMemory) << "," << endl;
+        out << "      \"counters\": ";
+        printCounters(out, stage.counters);
+        out << "," << endl;
+        out << "      \"functions\": [";
+
+        bool firstFunction = true;
+        foreach (const auto &function, stage.functions) {
+            out << (firstFunction ? "" : ",") << endl;
+            firstFunction = false;
+
+            out << "        {\"name\": " << toJson(function.name)
+                << ", \"wallTime\": " << toJson(function.wallTime)
+                << ", \"counters\": ";
+            printCounters(out, function.counters);
+            out << "}";
+        }
+
+        out << (firstFunction ? "" : "\n      ") << "]" << endl;
+        out << "    }";
+    }
+
+    out << (firstStage ? "" : "\n  ") << "]" << endl;
+    out << "}" << endl;
+}
+
+void Statistics::printTrace(QTextStream &out) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto finishTime = Usage::now().wallTime;
+
+    /* Trace event timestamps and durations are in microseconds. */
+    auto toMicroseconds = [](double seconds) { return QString::number(seconds * 1e6, 'f', 3); };
+
+    bool first = true;
+    auto printEvent = [&](const QString &name, const char *category, int thread, double start, double duration,
+                          const Counters &counters) {
+        out << (first ? "" : ",") << endl;
+        first = false;
+
+        out << "  {\"name\": " << toJson(name)
+            << ", \"cat\": \"" << category << "\""
+            << ", \"ph\": \"X\""
+            << ", \"pid\": 1"
+            << ", \"tid\": " << thread
+            << ", \"ts\": " << toMicroseconds(start - start_.wallTime)
+            << ", \"dur\": " << toMicroseconds(duration)
+            << ", \"args\": ";
+        printCounters(out, counters);
+        out << "}";
+    };
+
+    out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+
+    foreach (const auto &thread, threads_) {
+        out << (first ? "" : ",") << endl;
+        first = false;
+
+        out << "  {\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << thread.second
+            << ", \"args\": {\"name\": \"Thread " << thread.second << "\"}}";
+    }
+
+    foreach (const auto &stage, stages_) {
+        auto name = stage.pass > 1 ? QString("%1 (pass %2)").arg(stage.name).arg(stage.pass) : stage.name;
+        auto finish = stage.finished ? stage.finish.wallTime : finishTime;
+
+        printEvent(name, "stage", stage.thread, stage.start.wallTime, finish - stage.start.wallTime, stage.counters);
+
+        foreach (const auto &function, stage.functions) {
+            printEvent(function.name, "function", function.thread, function.start, function.wallTime, function.counters);
+        }
+    }
+
+    out << endl << "]}" << endl;
+}
+
+} // namespace core
+} // namespace nc
+
+/* vim:set et sts=4 sw=4: */
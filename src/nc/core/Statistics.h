@@ -0,0 +1,189 @@
+/* The file is part of Snowman decompiler. */
+/* See doc/licenses.asciidoc for the licensing information. */
+
+#pragma once
+
+#include <nc/config.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+#include <QString>
+
+QT_BEGIN_NAMESPACE
+class QTextStream;
+QT_END_NAMESPACE
+
+namespace nc {
+namespace core {
+
+/**
+ * Measurements of the time and memory spent in the stages of decompilation
+ * and in the analyses of individual functions.
+ *
+ * Functions of this class are safe to call concurrently.
+ */
+class Statistics: boost::noncopyable {
+public:
+    /**
+     * Resource usage of the process at some moment.
+     */
+    struct Usage {
+        double wallTime; ///< Wall clock time since an unspecified moment, in seconds.
+        double cpuTime; ///< CPU time consumed by all threads of the process, in seconds.
+        std::size_t memory; ///< Resident memory size, in bytes, or 0 if unknown.
+        std::size_t peakMemory; ///< Peak resident memory size, in bytes, or 0 if unknown.
+
+        /**
+         * \return Resource usage of the process at the moment of the call.
+         */
+        static Usage now();
+    };
+
+    /** Named counters, in the order of addition. */
+    typedef std::vector<std::pair<QString, std::int64_t>> Counters;
+
+    /**
+     * Measures a stage of decompilation from construction to destruction.
+     */
+    class Stage: boost::noncopyable {
+        Statistics *statistics_;
+        std::size_t index_;
+        Usage start_;
+        Counters counters_;
+
+    public:
+        /**
+         * Constructor. Starts the measurement.
+         *
+         * \param statistics Pointer to the statistics to record the stage in. Can be nullptr.
+         * \param name Name of the stage.
+         */
+        Stage(Statistics *statistics, const QString &name);
+
+        /**
+         * Destructor. Finishes the measurement and records it.
+         */
+        ~Stage();
+
+        /**
+         * Sets the value of a counter of the stage.
+         *
+         * \param name Name of the counter.
+         * \param value Value of the counter.
+         */
+        void setCounter(const QString &name, std::int64_t value) {
+            if (statistics_) {
+                counters_.push_back(std::make_pair(name, value));
+            }
+        }
+    };
+
+    /**
+     * Measures an analysis of a function, from construction to destruction.
+     * The measurement is attributed to the innermost stage being measured.
+     */
+    class Function: boost::noncopyable {
+        Statistics *statistics_;
+        QString name_;
+        double start_;
+        Counters counters_;
+
+    public:
+        /**
+         * Constructor. Starts the measurement.
+         *
+         * \param statistics Pointer to the statistics to record the analysis in. Can be nullptr.
+         * \param name Name of the function.
+         */
+        Function(Statistics *statistics, QString name);
+
+        /**
+         * Destructor. Finishes the measurement and records it.
+         */
+        ~Function();
+
+        /**
+         * Sets the value of a counter of the analysis.
+         *
+         * \param name Name of the counter.
+         * \param value Value of the counter.
+         */
+        void setCounter(const QString &name, std::int64_t value) {
+            if (statistics_) {
+                counters_.push_back(std::make_pair(name, value));
+            }
+        }
+    };
+
+    /**
+     * Constructor.
+     */
+    Statistics();
+
+    /**
+     * Destructor.
+     */
+    ~Statistics();
+
+    /**
+     * Prints the measurements in JSON format.
+     *
+     * \param out Output stream.
+     */
+    void print(QTextStream &out) const;
+
+    /**
+     * Prints the measurements as a trace in Chrome's trace event format,
+     * viewable in chrome://tracing or Perfetto. Stages and analyses of
+     * functions are printed as spans on the threads that executed them.
+     *
+     * \param out Output stream.
+     */
+    void printTrace(QTextStream &out) const;
+
+private:
+    struct FunctionRecord {
+        QString name;
+        double start;
+        double wallTime;
+        int thread;
+        Counters counters;
+    };
+
+    struct StageRecord {
+        QString name;
+        int pass;
+        bool finished;
+        int thread;
+        Usage start;
+        Usage finish;
+        Counters counters;
+        std::vector<FunctionRecord> functions;
+    };
+
+    mutable std::mutex mutex_;
+    Usage start_;
+    std::vector<StageRecord> stages_;
+    std::vector<std::size_t> openStages_;
+    std::map<std::thread::id, int> threads_; ///< Small numbers of the threads which reported measurements.
+
+    int getThreadNumber();
+
+    std::size_t beginStage(const QString &name, const Usage &start);
+    void endStage(std::size_t index, const Usage &finish, Counters counters);
+    void addFunction(FunctionRecord record);
+};
+
+} // namespace core
+} // namespace nc
+
+/* vim:set et sts=4 sw=4: */
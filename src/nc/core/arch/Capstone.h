@@ -104,6 +104,39 @@ public:
         return CapstoneInstructionPtr(insn, CapstoneDeleter(count));
     }
 
+    /**
+     * \return Pointer to a newly allocated instruction, to be filled by
+     *         disassemble(ByteAddr, const void *, ByteSize, cs_insn *).
+     */
+    CapstoneInstructionPtr allocateInstruction() {
+        auto insn = cs_malloc(handle_);
+        if (!insn) {
+            throw nc::Exception(cs_strerror(cs_errno(handle_)));
+        }
+        return CapstoneInstructionPtr(insn, CapstoneDeleter(1));
+    }
+
+    /**
+     * Disassembles a single instruction into a preallocated one,
+     * without allocating any memory.
+     *
+     * \param[in] pc Virtual address of the instruction.
+     * \param[in] buffer Valid pointer to the buffer containing the instruction.
+     * \param[in] size Buffer size.
+     * \param[out] insn Valid pointer to an instruction returned by allocateInstruction().
+     *
+     * \return True if disassembling succeeded, false otherwise.
+     */
+    bool disassemble(ByteAddr pc, const void *buffer, ByteSize size, cs_insn *insn) {
+        assert(insn != nullptr);
+
+        auto code = reinterpret_cast<const uint8_t *>(buffer);
+        auto codeSize = static_cast<std::size_t>(size);
+        uint64_t address = pc;
+
+        return cs_disasm_iter(handle_, &code, &codeSize, &address, insn);
+    }
+
     /**
      * Changes the mode to the given one.
      *
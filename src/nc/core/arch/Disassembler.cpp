@@ -4,12 +4,14 @@
 #include "Disassembler.h"
 
 #include <algorithm> /* std::max() */
+#include <vector>
 
 #include <nc/core/image/ByteSource.h>
 #include <nc/core/image/Image.h>
 #include <nc/core/image/Relocation.h>
 
 #include <nc/common/CancellationToken.h>
+#include <nc/common/Parallel.h>
 
 #include "Architecture.h"
 #include "Instruction.h"
@@ -22,28 +24,121 @@ void Disassembler::disassemble(const image::Image *image, const image::ByteSourc
     assert(source != nullptr);
     assert(begin <= end);
 
+    sweep(image, source, begin, end, end, callback, canceled);
+}
+
+void Disassembler::disassembleInParallel(const image::Image *image, const image::ByteSource *source, ByteAddr begin, ByteAddr end, InstructionCallback callback, const CancellationToken &canceled, int threadCount) {
+    assert(source != nullptr);
+    assert(begin <= end);
+
+    /* Chunks must be large enough for the resynchronization to be cheap compared to the sweep. */
+    const ByteSize minChunkSize = 1024 * 1024;
+
+    const std::size_t chunkCount = std::min<ByteSize>((end - begin) / minChunkSize, 4 * std::max(threadCount, 1));
+
+    /*
+     * Byte sources are not required to be thread-safe (e.g. the ones reading
+     * through the IDA SDK), so the chunks are only swept in parallel when
+     * the bytes are already in memory and no reads from the source are needed.
+     */
+    if (threadCount <= 1 || chunkCount <= 1 || !source->getSpan(begin, end - begin)) {
+        disassemble(image, source, begin, end, std::move(callback), canceled);
+        return;
+    }
+
+    auto chunkBegin = [&](std::size_t index) -> ByteAddr {
+        return index == chunkCount ? end : begin + (end - begin) / chunkCount * index;
+    };
+
+    /* Instructions found by sweeping each chunk from its beginning, and the addresses the sweeps stopped at. */
+    std::vector<std::vector<std::shared_ptr<Instruction>>> chunkInstructions(chunkCount);
+    std::vector<ByteAddr> chunkStops(chunkCount);
+
+    parallelFor(chunkCount, threadCount, [&](std::size_t index) {
+        auto disassembler = architecture_->createDisassembler();
+        auto &instructions = chunkInstructions[index];
+
+        chunkStops[index] = disassembler->sweep(image, source, chunkBegin(index), chunkBegin(index + 1), end,
+            [&](std::shared_ptr<Instruction> instruction) { instructions.push_back(std::move(instruction)); },
+            canceled);
+    });
+
+    /*
+     * The sweep of a chunk agrees with the serial sweep starting from the first
+     * instruction address they have in common. Until then, continue the serial sweep.
+     */
+    ByteAddr pc = begin;
+    for (std::size_t index = 0; index < chunkCount; ++index) {
+        auto &instructions = chunkInstructions[index];
+
+        auto findInstruction = [&](ByteAddr addr) {
+            return std::lower_bound(instructions.begin(), instructions.end(), addr,
+                [](const std::shared_ptr<Instruction> &instruction, ByteAddr addr) { return instruction->addr() < addr; });
+        };
+
+        pc = sweep(image, source, pc, chunkBegin(index + 1), end, callback, canceled, [&](ByteAddr addr) {
+            auto i = findInstruction(addr);
+            return i != instructions.end() && (*i)->addr() == addr;
+        });
+
+        if (pc < chunkBegin(index + 1)) {
+            for (auto i = findInstruction(pc); i != instructions.end(); ++i) {
+                callback(std::move(*i));
+            }
+            pc = chunkStops[index];
+        }
+
+        instructions.clear();
+        instructions.shrink_to_fit();
+    }
+}
+
+ByteAddr Disassembler::sweep(const image::Image *image, const image::ByteSource *source, ByteAddr begin, ByteAddr stop, ByteAddr end,
+                             const InstructionCallback &callback, const CancellationToken &canceled,
+                             const std::function<bool(ByteAddr)> &converged)
+{
+    assert(source != nullptr);
+    assert(stop <= end);
+
     const SmallByteSize maxInstructionSize = architecture_->maxInstructionSize();
-    const ByteSize bufferSize = std::min(ByteSize(std::max(65536, maxInstructionSize)), end - begin);
-    const std::unique_ptr<char[]> buffer(new char[bufferSize]);
+
+    /* If the source keeps the bytes contiguously in memory, decode them in place. */
+    const char *span = begin < end ? source->getSpan(begin, end - begin) : nullptr;
+
+    const ByteSize bufferSize = span || begin >= end ? 0 : std::min(ByteSize(std::max(65536, maxInstructionSize)), end - begin);
+    const std::unique_ptr<char[]> buffer(bufferSize ? new char[bufferSize] : nullptr);
+    const char *data = span ? span : buffer.get();
 
     auto bufferBegin = begin;
-    auto bufferEnd = begin;
+    auto bufferEnd = span ? end : begin;
+
+    /* Relocations are visited in step with pc. */
+    auto relocations = image->getRelocationsIn(begin, stop);
+    auto nextRelocation = relocations.begin();
+
+    ByteAddr pc = begin;
+    for (; pc < stop; canceled.poll()) {
+        if (converged && converged(pc)) {
+            break;
+        }
 
-    for (ByteAddr pc = begin; pc < end; canceled.poll()) {
         if (pc + maxInstructionSize > bufferEnd && bufferEnd < end) {
             bufferBegin = pc;
             bufferEnd = bufferBegin + source->readBytes(pc, buffer.get(), std::min(bufferSize, end - pc));
         }
 
-        const image::Relocation* reloc = image->getRelocation(pc);
+        while (nextRelocation != relocations.end() && (*nextRelocation)->address() < pc) {
+            ++nextRelocation;
+        }
+
         // If a relocation starts at a particular address it does make sense for there to be an instruction
         // there as well so skip over it
-        if (reloc) {
-            pc += reloc->size();
+        if (nextRelocation != relocations.end() && (*nextRelocation)->address() == pc) {
+            pc += (*nextRelocation)->size();
             continue;
         }
 
-        auto instruction = disassembleSingleInstruction(pc, buffer.get() + (pc - bufferBegin), bufferEnd - pc);
+        auto instruction = disassembleSingleInstruction(pc, data + (pc - bufferBegin), bufferEnd - pc);
 
         if (instruction) {
             assert(instruction->size() > 0);
@@ -53,10 +148,17 @@ void Disassembler::disassemble(const image::Image *image, const image::ByteSourc
             ++pc;
         }
     }
+
+    return pc;
 }
 
 std::shared_ptr<Instruction> Disassembler::disassembleSingleInstruction(ByteAddr pc, const image::ByteSource *source) {
     const SmallByteSize maxInstructionSize = architecture_->maxInstructionSize();
+
+    if (auto span = source->getSpan(pc, maxInstructionSize)) {
+        return disassembleSingleInstruction(pc, span, maxInstructionSize);
+    }
+
     const std::unique_ptr<char[]> buffer(new char[maxInstructionSize]);
 
     return disassembleSingleInstruction(
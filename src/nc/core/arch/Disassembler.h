@@ -63,6 +63,30 @@ public:
      */
     virtual void disassemble(const image::Image *image, const image::ByteSource *source, ByteAddr begin, ByteAddr end, InstructionCallback callback, const CancellationToken &canceled);
 
+    /**
+     * Disassembles all instructions in the given range of addresses, like disassemble() does.
+     *
+     * Large ranges are split into chunks, each of which is disassembled
+     * in a separate thread by a separate disassembler instance starting from
+     * the chunk's beginning. Instruction boundaries at the seams between the chunks
+     * are then resynchronized with the sequence that a serial sweep would produce,
+     * so that the result is identical to the one of disassemble().
+     *
+     * The range is only split when the source gives direct access to
+     * all its bytes via ByteSource::getSpan(); otherwise, it is disassembled
+     * serially, so that no concurrent reads from the source happen.
+     *
+     * The callback is called in the calling thread, in the order of increasing addresses.
+     *
+     * \param source Valid pointer to a byte source.
+     * \param begin First address in the range.
+     * \param end First address past the range.
+     * \param callback Function being called for each disassembled instruction.
+     * \param canceled Cancellation token.
+     * \param threadCount Maximal number of threads to use.
+     */
+    void disassembleInParallel(const image::Image *image, const image::ByteSource *source, ByteAddr begin, ByteAddr end, InstructionCallback callback, const CancellationToken &canceled, int threadCount);
+
     /**
      * Disassembles a single instruction.
      *
@@ -83,6 +107,24 @@ public:
      * \return Pointer to the instruction disassembled from the buffer if disassembling succeeded, nullptr otherwise.
      */
     virtual std::shared_ptr<Instruction> disassembleSingleInstruction(ByteAddr pc, const image::ByteSource *source);
+
+private:
+    /**
+     * Disassembles instructions one after another, starting from the given address.
+     *
+     * \param source Valid pointer to a byte source.
+     * \param begin Address to start from.
+     * \param stop Address before which the last instruction must start.
+     * \param end First address past the bytes which instructions may occupy. Must be not less than stop.
+     * \param callback Function being called for each disassembled instruction.
+     * \param canceled Cancellation token.
+     * \param converged If not empty, the sweep stops as soon as this function returns true for the current address.
+     *
+     * \return Address at which the sweep has stopped.
+     */
+    ByteAddr sweep(const image::Image *image, const image::ByteSource *source, ByteAddr begin, ByteAddr stop, ByteAddr end,
+                   const InstructionCallback &callback, const CancellationToken &canceled,
+                   const std::function<bool(ByteAddr)> &converged = std::function<bool(ByteAddr)>());
 };
 
 } // namespace arch
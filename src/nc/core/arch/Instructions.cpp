@@ -24,6 +24,8 @@
 
 #include "Instructions.h"
 
+#include <algorithm>
+
 #include <QTextStream>
 
 #include <nc/common/Foreach.h>
@@ -32,37 +34,132 @@ namespace nc {
 namespace core {
 namespace arch {
 
+namespace {
+
+/** Preferred number of instructions in a chunk. Chunks twice as large are split. */
+const std::size_t chunkSize = 1024;
+
+const std::shared_ptr<const Instruction> nullInstruction;
+
+} // anonymous namespace
+
+std::size_t Instructions::findChunk(ByteAddr addr) const {
+    assert(!chunks_.empty());
+
+    auto i = std::upper_bound(chunks_.begin(), chunks_.end(), addr,
+        [](ByteAddr addr, const std::shared_ptr<Chunk> &chunk) { return addr < chunk->front()->addr(); });
+
+    return i == chunks_.begin() ? 0 : static_cast<std::size_t>(i - chunks_.begin() - 1);
+}
+
+Instructions::Chunk::const_iterator Instructions::lowerBound(const Chunk &chunk, ByteAddr addr) {
+    return std::lower_bound(chunk.begin(), chunk.end(), addr,
+        [](const std::shared_ptr<const Instruction> &instruction, ByteAddr addr) { return instruction->addr() < addr; });
+}
+
+Instructions::Chunk &Instructions::modifiableChunk(std::size_t chunkIndex) {
+    auto &chunk = chunks_[chunkIndex];
+    if (chunk.use_count() != 1) {
+        chunk = std::make_shared<Chunk>(*chunk);
+    }
+    return *chunk;
+}
+
+const std::shared_ptr<const Instruction> &Instructions::get(ByteAddr addr) const {
+    if (chunks_.empty()) {
+        return nullInstruction;
+    }
+
+    const auto &chunk = *chunks_[findChunk(addr)];
+    auto i = lowerBound(chunk, addr);
+
+    if (i != chunk.end() && (*i)->addr() == addr) {
+        return *i;
+    } else {
+        return nullInstruction;
+    }
+}
+
 const std::shared_ptr<const Instruction> &Instructions::getCovering(ByteAddr addr) const {
-    auto i = address2instruction_.lower_bound(addr);
+    if (chunks_.empty()) {
+        return nullInstruction;
+    }
 
-    if (i != address2instruction_.end() &&
-        i->second->addr() <= addr && addr < i->second->endAddr())
-    {
-        return i->second;
+    const auto &chunk = *chunks_[findChunk(addr)];
+    auto i = std::upper_bound(chunk.begin(), chunk.end(), addr,
+        [](ByteAddr addr, const std::shared_ptr<const Instruction> &instruction) { return addr < instruction->addr(); });
+
+    if (i != chunk.begin() && addr < (*--i)->endAddr()) {
+        return *i;
     } else {
-        static const std::shared_ptr<const Instruction> null;
-        return null;
+        return nullInstruction;
     }
 }
 
 bool Instructions::add(std::shared_ptr<const Instruction> instruction) {
     assert(instruction != nullptr);
 
-    auto &existing = address2instruction_[instruction->addr()];
-    if (!existing) {
-        existing = instruction;
+    if (chunks_.empty()) {
+        chunks_.push_back(std::make_shared<Chunk>());
+        chunks_.back()->reserve(chunkSize);
+        chunks_.back()->push_back(std::move(instruction));
+        size_ = 1;
         return true;
+    }
+
+    auto chunkIndex = findChunk(instruction->addr());
+    const auto &existingChunk = *chunks_[chunkIndex];
+
+    /* Fast path for adding instructions in the order of increasing addresses. */
+    std::size_t position;
+    if (existingChunk.back()->addr() < instruction->addr()) {
+        position = existingChunk.size();
     } else {
-        return false;
+        auto i = lowerBound(existingChunk, instruction->addr());
+        if (i != existingChunk.end() && (*i)->addr() == instruction->addr()) {
+            return false;
+        }
+        position = i - existingChunk.begin();
     }
+
+    auto &chunk = modifiableChunk(chunkIndex);
+    chunk.insert(chunk.begin() + position, std::move(instruction));
+    ++size_;
+
+    if (chunk.size() >= 2 * chunkSize) {
+        auto tail = std::make_shared<Chunk>(chunk.begin() + chunkSize, chunk.end());
+        tail->reserve(chunkSize);
+        chunk.erase(chunk.begin() + chunkSize, chunk.end());
+        chunks_.insert(chunks_.begin() + chunkIndex + 1, std::move(tail));
+    }
+
+    return true;
 }
 
 bool Instructions::remove(const Instruction *instruction) {
-    if (get(instruction->addr()).get() == instruction) {
-        return address2instruction_.erase(instruction->addr());
-    } else {
+    assert(instruction != nullptr);
+
+    if (chunks_.empty()) {
+        return false;
+    }
+
+    auto chunkIndex = findChunk(instruction->addr());
+    auto i = lowerBound(*chunks_[chunkIndex], instruction->addr());
+
+    if (i == chunks_[chunkIndex]->end() || i->get() != instruction) {
         return false;
     }
+
+    auto position = i - chunks_[chunkIndex]->begin();
+    auto &chunk = modifiableChunk(chunkIndex);
+    chunk.erase(chunk.begin() + position);
+    --size_;
+
+    if (chunk.empty()) {
+        chunks_.erase(chunks_.begin() + chunkIndex);
+    }
+
+    return true;
 }
 
 void Instructions::print(QTextStream &out, PrintCallback<const Instruction *> *callback) const {
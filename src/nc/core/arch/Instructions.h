@@ -25,13 +25,14 @@
 
 #include <nc/config.h>
 
-#include <map>
+#include <cstddef>
 #include <memory> /* std::shared_ptr */
+#include <vector>
 
-#include <boost/range/adaptor/map.hpp>
+#include <boost/iterator/iterator_facade.hpp>
+#include <boost/range/iterator_range.hpp>
 
 #include <nc/common/PrintCallback.h>
-#include <nc/common/Range.h> /* nc::find */
 
 #include "Instruction.h"
 
@@ -41,22 +42,74 @@ class Instruction;
 
 /**
  * Class representing a set of instructions.
+ *
+ * Instructions are stored sorted by their addresses in chunks of bounded size.
+ * Chunks are shared between copies of the set and are copied only when
+ * a copy modifies them. Therefore, copying a set costs time proportional
+ * to the number of chunks, and adding instructions to a copy costs time
+ * proportional to the number of added instructions and touched chunks.
  */
 class Instructions {
-    /** Type of mapping of addresses to instruction. */
-    typedef std::map<ByteAddr, std::shared_ptr<const Instruction>> AddressInstructionMap;
+    /** Type of a chunk: instructions sorted by their addresses. */
+    typedef std::vector<std::shared_ptr<const Instruction>> Chunk;
+
+    /** Chunks of instructions sorted by their addresses. Chunks are never empty. */
+    std::vector<std::shared_ptr<Chunk>> chunks_;
 
-    /** Mapping of addresses to instructions. */
-    AddressInstructionMap address2instruction_;
+    /** Number of instructions in the set. */
+    std::size_t size_;
 
 public:
+    /**
+     * Iterator over the instructions sorted by their addresses.
+     */
+    class ConstIterator: public boost::iterator_facade<
+        ConstIterator, const std::shared_ptr<const Instruction>, boost::forward_traversal_tag>
+    {
+        const std::vector<std::shared_ptr<Chunk>> *chunks_;
+        std::size_t chunkIndex_;
+        std::size_t index_;
+
+    public:
+        ConstIterator(): chunks_(nullptr), chunkIndex_(0), index_(0) {}
+
+        ConstIterator(const std::vector<std::shared_ptr<Chunk>> *chunks, std::size_t chunkIndex):
+            chunks_(chunks), chunkIndex_(chunkIndex), index_(0)
+        {}
+
+    private:
+        friend class boost::iterator_core_access;
+
+        void increment() {
+            if (++index_ == (*chunks_)[chunkIndex_]->size()) {
+                ++chunkIndex_;
+                index_ = 0;
+            }
+        }
+
+        bool equal(const ConstIterator &that) const {
+            return chunkIndex_ == that.chunkIndex_ && index_ == that.index_;
+        }
+
+        const std::shared_ptr<const Instruction> &dereference() const {
+            return (*(*chunks_)[chunkIndex_])[index_];
+        }
+    };
+
     /** Type for the sorted range of instructions. */
-    typedef boost::select_second_const_range<AddressInstructionMap> InstructionsRange;
+    typedef boost::iterator_range<ConstIterator> InstructionsRange;
+
+    /**
+     * Constructor. Creates an empty set.
+     */
+    Instructions(): size_(0) {}
 
     /**
      * \return Range of instructions sorted by their addresses in ascending order.
      */
-    InstructionsRange all() const { return address2instruction_ | boost::adaptors::map_values; }
+    InstructionsRange all() const {
+        return InstructionsRange(ConstIterator(&chunks_, 0), ConstIterator(&chunks_, chunks_.size()));
+    }
 
     /**
      * \param[in] addr Address.
@@ -64,7 +117,7 @@ public:
      * \return Pointer to the instruction starting at the given address.
      *         Can be nullptr, if there is no such instructions.
      */
-    const std::shared_ptr<const Instruction> &get(ByteAddr addr) const { return nc::find(address2instruction_, addr); }
+    const std::shared_ptr<const Instruction> &get(ByteAddr addr) const;
 
     /**
      * \param[in] addr Address.
@@ -77,6 +130,8 @@ public:
     /**
      * Adds instruction if there is no instruction with the given address yet.
      *
+     * Adding instructions in the order of increasing addresses is the fastest.
+     *
      * \param instruction Valid pointer to an instruction.
      *
      * \return True if the instruction was added, false otherwise.
@@ -95,7 +150,7 @@ public:
     /**
      * \return Number of instructions in the set.
      */
-    std::size_t size() const { return address2instruction_.size(); }
+    std::size_t size() const { return size_; }
 
     /**
      * \return True if the set is empty, false is otherwise.
@@ -109,6 +164,34 @@ public:
      * \param callback Pointer to the print callback. Can be nullptr.
      */
     void print(QTextStream &out, PrintCallback<const Instruction *> *callback = nullptr) const;
+
+private:
+    /**
+     * \param[in] addr Address.
+     *
+     * \return Index of the chunk where an instruction with the given address is or would be stored.
+     *         Must not be called on an empty set.
+     */
+    std::size_t findChunk(ByteAddr addr) const;
+
+    /**
+     * \param[in] chunk Chunk.
+     * \param[in] addr Address.
+     *
+     * \return Iterator pointing to the first instruction in the chunk
+     *         with the address greater or equal to the given one.
+     */
+    static Chunk::const_iterator lowerBound(const Chunk &chunk, ByteAddr addr);
+
+    /**
+     * Makes sure that the chunk with the given index is not shared
+     * with other sets, copying it if necessary.
+     *
+     * \param[in] chunkIndex Index of the chunk.
+     *
+     * \return Reference to the chunk.
+     */
+    Chunk &modifiableChunk(std::size_t chunkIndex);
 };
 
 }}} // namespace nc::core::arch
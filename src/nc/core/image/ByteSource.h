@@ -51,6 +51,25 @@ public:
      * \return Number of bytes actually read and copied into the buffer.
      */
     virtual ByteSize readBytes(ByteAddr addr, void *buf, ByteSize size) const = 0;
+
+    /**
+     * Gives direct access to a sequence of bytes, if the source stores
+     * them contiguously in memory.
+     *
+     * \param[in] addr  Linear address of the first byte.
+     * \param[in] size  Number of bytes.
+     *
+     * \return Pointer to the memory holding the bytes from [addr, addr + size),
+     *         or nullptr if the source cannot give such a pointer.
+     *         The memory is valid as long as the source exists and is never
+     *         modified, so it may be read from several threads at once.
+     *         Unlike getSpan(), readBytes() need not be thread-safe.
+     */
+    virtual const char *getSpan(ByteAddr addr, ByteSize size) const {
+        (void)addr;
+        (void)size;
+        return nullptr;
+    }
 };
 
 } // namespace image
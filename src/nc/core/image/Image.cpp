@@ -24,6 +24,8 @@
 
 #include "Image.h"
 
+#include <algorithm>
+
 #include <nc/common/Foreach.h>
 #include <nc/common/Range.h>
 #include <nc/common/make_unique.h>
@@ -37,6 +39,8 @@
 namespace nc { namespace core { namespace image {
 
 Image::Image():
+    lastSectionRange_(0),
+    relocationsSorted_(true),
     demangler_(new mangling::DefaultDemangler())
 {}
 
@@ -44,15 +48,57 @@ Image::~Image() {}
 
 void Image::addSection(std::unique_ptr<Section> section) {
     assert(section != nullptr);
+
+    if (section->isAllocated() && section->size() > 0) {
+        /*
+         * Add ranges covering the addresses of the section
+         * that are not covered by previously added sections.
+         */
+        auto addr = section->addr();
+        auto i = std::upper_bound(sectionRanges_.begin(), sectionRanges_.end(), addr,
+            [](ByteAddr addr, const SectionRange &range) { return addr < range.begin; });
+
+        if (i != sectionRanges_.begin()) {
+            addr = std::max(addr, (i - 1)->end);
+        }
+
+        while (addr < section->endAddr()) {
+            if (i != sectionRanges_.end() && i->begin <= addr) {
+                addr = i->end;
+                ++i;
+            } else {
+                auto end = section->endAddr();
+                if (i != sectionRanges_.end()) {
+                    end = std::min(end, i->begin);
+                }
+                i = sectionRanges_.insert(i, SectionRange(addr, end, section.get())) + 1;
+                addr = end;
+            }
+        }
+    }
+
     sections_.push_back(std::move(section));
 }
 
 const Section *Image::getSectionContainingAddress(ByteAddr addr) const {
-    foreach (auto section, sections()) {
-        if (section->isAllocated() && section->containsAddress(addr)) {
-            return section;
+    /* Consecutive lookups tend to hit the same section. */
+    auto index = lastSectionRange_.load(std::memory_order_relaxed);
+    if (index < sectionRanges_.size()) {
+        const auto &range = sectionRanges_[index];
+        if (range.begin <= addr && addr < range.end) {
+            return range.section;
         }
     }
+
+    auto i = std::upper_bound(sectionRanges_.begin(), sectionRanges_.end(), addr,
+        [](ByteAddr addr, const SectionRange &range) { return addr < range.begin; });
+
+    if (i != sectionRanges_.begin() && addr < (i - 1)->end) {
+        --i;
+        lastSectionRange_.store(i - sectionRanges_.begin(), std::memory_order_relaxed);
+        return i->section;
+    }
+
     return nullptr;
 }
 
@@ -73,6 +119,14 @@ ByteSize Image::readBytes(ByteAddr addr, void *buf, ByteSize size) const {
     }
 }
 
+const char *Image::getSpan(ByteAddr addr, ByteSize size) const {
+    if (const Section *section = getSectionContainingAddress(addr)) {
+        return section->getSpan(addr, size);
+    } else {
+        return nullptr;
+    }
+}
+
 const Symbol *Image::addSymbol(std::unique_ptr<Symbol> symbol) {
     auto result = symbol.get();
 
@@ -93,19 +147,94 @@ const Relocation *Image::addRelocation(std::unique_ptr<Relocation> relocation) {
     auto result = relocation.get();
 
     relocations_.push_back(std::move(relocation));
-    address2relocation_[result->address()] = result;
+    relocationsSorted_ = false;
 
     return result;
 }
 
+void Image::sortRelocations() const {
+    if (relocationsSorted_.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(sortedRelocationsMutex_);
+
+    if (relocationsSorted_.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    sortedRelocations_.clear();
+    sortedRelocations_.reserve(relocations_.size());
+    foreach (const auto &relocation, relocations_) {
+        sortedRelocations_.push_back(relocation.get());
+    }
+
+    /* Stable sort keeps relocations with equal addresses in the order they were added. */
+    std::stable_sort(sortedRelocations_.begin(), sortedRelocations_.end(),
+        [](const Relocation *a, const Relocation *b) { return a->address() < b->address(); });
+
+    /* Of the relocations with equal addresses, keep the one added last. */
+    std::size_t size = 0;
+    foreach (auto relocation, sortedRelocations_) {
+        if (size > 0 && sortedRelocations_[size - 1]->address() == relocation->address()) {
+            sortedRelocations_[size - 1] = relocation;
+        } else {
+            sortedRelocations_[size++] = relocation;
+        }
+    }
+    sortedRelocations_.resize(size);
+
+    relocationsSorted_.store(true, std::memory_order_release);
+}
+
 const Relocation *Image::getRelocation(ByteAddr address) const {
-    return nc::find(address2relocation_, address);
+    sortRelocations();
+
+    auto i = std::lower_bound(sortedRelocations_.begin(), sortedRelocations_.end(), address,
+        [](const Relocation *relocation, ByteAddr address) { return relocation->address() < address; });
+
+    if (i != sortedRelocations_.end() && (*i)->address() == address) {
+        return *i;
+    }
+    return nullptr;
+}
+
+Image::RelocationsRange Image::getRelocationsIn(ByteAddr begin, ByteAddr end) const {
+    sortRelocations();
+
+    auto less = [](const Relocation *relocation, ByteAddr address) { return relocation->address() < address; };
+
+    auto first = std::lower_bound(sortedRelocations_.begin(), sortedRelocations_.end(), begin, less);
+    auto last = std::lower_bound(first, sortedRelocations_.end(), std::max(begin, end), less);
+
+    return RelocationsRange(first, last);
 }
 
 void Image::setDemangler(std::unique_ptr<mangling::Demangler> demangler) {
     assert(demangler != nullptr);
 
     demangler_ = std::move(demangler);
+
+    std::lock_guard<std::mutex> lock(demangledNamesMutex_);
+    demangledNames_.clear();
+}
+
+QString Image::getDemangledName(const Symbol *symbol) const {
+    assert(symbol != nullptr);
+
+    {
+        std::lock_guard<std::mutex> lock(demangledNamesMutex_);
+        auto i = demangledNames_.find(symbol);
+        if (i != demangledNames_.end()) {
+            return i->second;
+        }
+    }
+
+    /* Demangle without holding the lock: demangling can be slow. */
+    auto result = demangler_->demangle(symbol->name());
+
+    std::lock_guard<std::mutex> lock(demangledNamesMutex_);
+    return demangledNames_.insert(std::make_pair(symbol, std::move(result))).first->second;
 }
 
 }}} // namespace nc::core::image
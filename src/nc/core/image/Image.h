@@ -25,9 +25,13 @@
 
 #include <nc/config.h>
 
+#include <atomic>
+#include <cstddef>
 #include <memory>
+#include <mutex>
 #include <vector>
 
+#include <boost/range/iterator_range.hpp>
 #include <boost/unordered_map.hpp>
 
 #include <QString>
@@ -55,13 +59,48 @@ class Relocation;
  * An executable image.
  */
 class Image: public ByteSource {
+    /**
+     * Range of addresses belonging to a single section.
+     */
+    struct SectionRange {
+        ByteAddr begin; ///< First address of the range.
+        ByteAddr end; ///< Address following the last address of the range.
+        const Section *section; ///< Section the addresses belong to.
+
+        SectionRange(ByteAddr begin, ByteAddr end, const Section *section):
+            begin(begin), end(end), section(section)
+        {}
+    };
+
     Platform platform_;
     std::vector<std::unique_ptr<Section>> sections_; ///< The list of sections.
+
+    /**
+     * Disjoint ranges of addresses of allocated sections, sorted by their beginnings.
+     * Where sections overlap, the addresses belong to the section added first.
+     */
+    std::vector<SectionRange> sectionRanges_;
+
+    /** Index of the section range in which the last lookup succeeded. */
+    mutable std::atomic<std::size_t> lastSectionRange_;
     std::vector<std::unique_ptr<Symbol>> symbols_; ///< The list of symbols.
     boost::unordered_map<ConstantValue, Symbol *> value2symbol_; ///< Mapping from value to the symbol with this value.
     std::vector<std::unique_ptr<Relocation>> relocations_; ///< The list of relocations.
-    boost::unordered_map<ByteAddr, Relocation *> address2relocation_; ///< Mapping from an address to the relocation with this address.
+
+    /**
+     * Relocations sorted by their addresses, one per address.
+     * Where several relocations have the same address, the one added last is kept.
+     * Built lazily on the first lookup after relocations were added.
+     */
+    mutable std::vector<const Relocation *> sortedRelocations_;
+
+    /** True if sortedRelocations_ is up to date with relocations_. */
+    mutable std::atomic<bool> relocationsSorted_;
+    mutable std::mutex sortedRelocationsMutex_; ///< Mutex guarding the construction of sortedRelocations_.
+
     std::unique_ptr<mangling::Demangler> demangler_; ///< Demangler.
+    mutable boost::unordered_map<const Symbol *, QString> demangledNames_; ///< Cached demangled names of symbols.
+    mutable std::mutex demangledNamesMutex_; ///< Mutex guarding demangledNames_.
     boost::optional<ByteAddr> entrypoint_; ///< Entrypoint of image.
 
 public:
@@ -87,6 +126,8 @@ public:
 
     /**
      * Adds a new section.
+     * The address, the size, and whether the section is allocated,
+     * must not change after the section is added.
      *
      * \param section Valid pointer to the section.
      */
@@ -111,6 +152,7 @@ public:
      *
      * \return A valid pointer to allocated section containing given
      *         virtual address or nullptr if there is no such section.
+     *         If several sections contain the address, the one added first is returned.
      */
     const Section *getSectionContainingAddress(ByteAddr addr) const;
 
@@ -128,6 +170,13 @@ public:
      */
     ByteSize readBytes(ByteAddr addr, void *buf, ByteSize size) const override;
 
+    /**
+     * Gives direct access to a sequence of bytes from the section containing
+     * the given address and allocated during program execution.
+     * The sequence must lie entirely within the section.
+     */
+    const char *getSpan(ByteAddr addr, ByteSize size) const override;
+
     /**
      * Adds a symbol.
      *
@@ -162,6 +211,13 @@ public:
      */
     const Relocation *addRelocation(std::unique_ptr<Relocation> relocation);
 
+    /**
+     * \return List of all relocations.
+     */
+    const std::vector<const Relocation *> &relocations() const {
+        return reinterpret_cast<const std::vector<const Relocation *> &>(relocations_);
+    }
+
     /**
      * \param address Virtual address.
      *
@@ -169,6 +225,18 @@ public:
      */
     const Relocation *getRelocation(ByteAddr address) const;
 
+    /** Type for the range of relocations sorted by their addresses. */
+    typedef boost::iterator_range<std::vector<const Relocation *>::const_iterator> RelocationsRange;
+
+    /**
+     * \param begin First address of the range.
+     * \param end First address past the range.
+     *
+     * \return Relocations with addresses in the given range, sorted by their addresses,
+     *         one per address (see getRelocation()).
+     */
+    RelocationsRange getRelocationsIn(ByteAddr begin, ByteAddr end) const;
+
     /**
      * \return Valid pointer to a demangler.
      */
@@ -181,6 +249,17 @@ public:
      */
     void setDemangler(std::unique_ptr<mangling::Demangler> demangler);
 
+    /**
+     * Demangles the name of a symbol using the demangler of the image.
+     * The result is cached, so that each symbol is normally demangled once.
+     * This function is safe to call concurrently.
+     *
+     * \param symbol Valid pointer to a symbol.
+     *
+     * \return Demangled name of the symbol, or QString() in case of failure.
+     */
+    QString getDemangledName(const Symbol *symbol) const;
+
     /**
      * Sets the entry point address.
      *
@@ -192,6 +271,13 @@ public:
      * \return Address of the entry point.
      */
     const boost::optional<ByteAddr> &entrypoint() const { return entrypoint_; }
+
+private:
+    /**
+     * Rebuilds sortedRelocations_ if relocations were added since the last build.
+     * This function is safe to call concurrently.
+     */
+    void sortRelocations() const;
 };
 
 }}} // namespace nc::core::image
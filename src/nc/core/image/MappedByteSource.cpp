@@ -0,0 +1,56 @@
+/* The file is part of Snowman decompiler. */
+/* See doc/licenses.asciidoc for the licensing information. */
+
+#include "MappedByteSource.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring> /* memcpy */
+
+#include "MappedFile.h"
+
+namespace nc {
+namespace core {
+namespace image {
+
+MappedByteSource::MappedByteSource(std::shared_ptr<const MappedFile> file, ByteAddr addr, ByteSize offset, ByteSize size):
+    file_(std::move(file)), addr_(addr), offset_(offset), size_(size)
+{
+    assert(file_ != nullptr);
+    assert(file_->contains(offset, size));
+}
+
+const char *MappedByteSource::data() const {
+    return file_->data() + offset_;
+}
+
+ByteSize MappedByteSource::readBytes(ByteAddr addr, void *buf, ByteSize size) const {
+    auto offset = addr - addr_;
+
+    if (offset < 0 || offset >= size_) {
+        return 0;
+    }
+
+    size = std::min(size, size_ - offset);
+    if (size > 0) {
+        memcpy(buf, data() + offset, size);
+    }
+
+    return size;
+}
+
+const char *MappedByteSource::getSpan(ByteAddr addr, ByteSize size) const {
+    auto offset = addr - addr_;
+
+    if (offset < 0 || size < 0 || offset > size_ || size > size_ - offset) {
+        return nullptr;
+    }
+
+    return data() + offset;
+}
+
+} // namespace image
+} // namespace core
+} // namespace nc
+
+/* vim:set et sts=4 sw=4: */
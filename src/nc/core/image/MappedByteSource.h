@@ -0,0 +1,62 @@
+/* The file is part of Snowman decompiler. */
+/* See doc/licenses.asciidoc for the licensing information. */
+
+#pragma once
+
+#include <nc/config.h>
+
+#include <memory>
+
+#include <nc/common/Types.h>
+
+#include "ByteSource.h"
+
+namespace nc {
+namespace core {
+namespace image {
+
+class MappedFile;
+
+/**
+ * Byte source taking bytes directly from a memory-mapped file.
+ *
+ * The source maps a range of linear addresses to a range of file offsets.
+ * It keeps the mapping alive as long as the source exists.
+ */
+class MappedByteSource: public ByteSource {
+    std::shared_ptr<const MappedFile> file_; ///< Mapped file.
+    ByteAddr addr_; ///< Linear address of the first byte.
+    ByteSize offset_; ///< Offset of the first byte in the file.
+    ByteSize size_; ///< Number of bytes.
+
+public:
+    /**
+     * Constructor.
+     *
+     * \param file   Valid pointer to the mapped file.
+     * \param addr   Linear address of the first byte.
+     * \param offset Offset of the first byte in the file.
+     * \param size   Number of bytes. The range [offset, offset + size) must lie within the file.
+     */
+    MappedByteSource(std::shared_ptr<const MappedFile> file, ByteAddr addr, ByteSize offset, ByteSize size);
+
+    /**
+     * \return Valid pointer to the first byte of the mapped range.
+     */
+    const char *data() const;
+
+    /**
+     * \return Number of bytes in the mapped range.
+     */
+    ByteSize size() const { return size_; }
+
+    ByteSize readBytes(ByteAddr addr, void *buf, ByteSize size) const override;
+
+    const char *getSpan(ByteAddr addr, ByteSize size) const override;
+};
+
+} // namespace image
+} // namespace core
+} // namespace nc
+
+/* vim:set et sts=4 sw=4: */
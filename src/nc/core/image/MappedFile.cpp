@@ -0,0 +1,59 @@
+/* The file is part of Snowman decompiler. */
+/* See doc/licenses.asciidoc for the licensing information. */
+
+#include "MappedFile.h"
+
+#include <cassert>
+
+#include <QIODevice>
+
+namespace nc {
+namespace core {
+namespace image {
+
+MappedFile::MappedFile(const QString &fileName):
+    file_(fileName), data_(nullptr), size_(0)
+{}
+
+MappedFile::~MappedFile() {
+    if (data_) {
+        file_.unmap(reinterpret_cast<uchar *>(const_cast<char *>(data_)));
+    }
+}
+
+std::shared_ptr<MappedFile> MappedFile::map(QIODevice *device) {
+    assert(device != nullptr);
+
+    auto file = qobject_cast<QFile *>(device);
+    if (!file) {
+        return nullptr;
+    }
+
+    /* A separate QFile, so that the mapping does not depend on the lifetime of the device. */
+    std::shared_ptr<MappedFile> result(new MappedFile(file->fileName()));
+
+    if (!result->file_.open(QIODevice::ReadOnly)) {
+        return nullptr;
+    }
+
+    auto size = result->file_.size();
+    if (size <= 0) {
+        return nullptr;
+    }
+
+    auto data = result->file_.map(0, size);
+    if (!data) {
+        return nullptr;
+    }
+
+    result->data_ = reinterpret_cast<const char *>(data);
+    result->size_ = size;
+
+    return result;
+}
+
+} // namespace image
+} // namespace core
+} // namespace nc
+
+/* vim:set et sts=4 sw=4: */
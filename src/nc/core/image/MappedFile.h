@@ -0,0 +1,82 @@
+/* The file is part of Snowman decompiler. */
+/* See doc/licenses.asciidoc for the licensing information. */
+
+#pragma once
+
+#include <nc/config.h>
+
+#include <memory>
+
+#include <QFile>
+
+#include <boost/noncopyable.hpp>
+
+#include <nc/common/Types.h>
+
+QT_BEGIN_NAMESPACE
+class QIODevice;
+QT_END_NAMESPACE
+
+namespace nc {
+namespace core {
+namespace image {
+
+/**
+ * Read-only memory mapping of a whole file.
+ *
+ * The file stays open and mapped for the lifetime of the object.
+ */
+class MappedFile: boost::noncopyable {
+    QFile file_; ///< Mapped file.
+    const char *data_; ///< Pointer to the beginning of the mapped file contents.
+    ByteSize size_; ///< Size of the file.
+
+    /**
+     * Constructor.
+     *
+     * \param fileName Name of the file.
+     */
+    explicit MappedFile(const QString &fileName);
+
+public:
+    /**
+     * Destructor. Unmaps and closes the file.
+     */
+    ~MappedFile();
+
+    /**
+     * Maps into memory the file from which the given device reads.
+     *
+     * \param device Valid pointer to an I/O device.
+     *
+     * \return Pointer to the mapping, or nullptr if the device is not a file
+     *         or the file could not be mapped.
+     */
+    static std::shared_ptr<MappedFile> map(QIODevice *device);
+
+    /**
+     * \return Valid pointer to the beginning of the mapped file contents.
+     */
+    const char *data() const { return data_; }
+
+    /**
+     * \return Size of the file.
+     */
+    ByteSize size() const { return size_; }
+
+    /**
+     * \param offset Offset from the beginning of the file.
+     * \param size   Size of the range.
+     *
+     * \return True if the range of bytes lies entirely within the file.
+     */
+    bool contains(ByteSize offset, ByteSize size) const {
+        return 0 <= offset && 0 <= size && offset <= size_ && size <= size_ - offset;
+    }
+};
+
+} // namespace image
+} // namespace core
+} // namespace nc
+
+/* vim:set et sts=4 sw=4: */
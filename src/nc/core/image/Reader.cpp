@@ -34,6 +34,10 @@ ByteSize Reader::readBytes(ByteAddr addr, void *buf, ByteSize size) const {
     return externalByteSource_->readBytes(addr, buf, size);
 }
 
+const char *Reader::getSpan(ByteAddr addr, ByteSize size) const {
+    return externalByteSource_->getSpan(addr, size);
+}
+
 QString Reader::readAsciizString(ByteAddr addr, ByteSize maxSize) const {
     assert(maxSize >= 0);
 
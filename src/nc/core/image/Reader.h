@@ -27,8 +27,13 @@
 
 #include <algorithm>
 #include <cassert>
-#include <cstring> /* memset */
+#include <climits> /* CHAR_BIT */
+#include <cstddef>
+#include <cstdint>
+#include <cstring> /* memcpy */
+#include <limits>
 #include <memory>
+#include <type_traits>
 
 #include <boost/optional.hpp>
 
@@ -71,6 +76,11 @@ public:
      */
     ByteSize readBytes(ByteAddr addr, void *buf, ByteSize size) const override;
 
+    /**
+     * Gives direct access to a sequence of bytes of the external byte source.
+     */
+    const char *getSpan(ByteAddr addr, ByteSize size) const override;
+
     /**
      * Reads an integer value.
      *
@@ -89,21 +99,77 @@ public:
         assert(size >= 0);
         assert(byteOrder != ByteOrder::Unknown);
 
-        std::unique_ptr<char[]> buf(new char[std::max<std::size_t>(size, sizeof(T))]);
+        if (auto span = getSpan(addr, size)) {
+            return decodeInt<T>(span, size, byteOrder);
+        }
+
+        char stackBuffer[2 * sizeof(uint64_t)];
+        std::unique_ptr<char[]> heapBuffer;
+        char *buf = stackBuffer;
+
+        if (static_cast<std::size_t>(size) > sizeof(stackBuffer)) {
+            heapBuffer.reset(new char[size]);
+            buf = heapBuffer.get();
+        }
 
-        if (readBytes(addr, buf.get(), size) != size) {
+        if (readBytes(addr, buf, size) != size) {
             return boost::none;
         }
 
-        ByteOrder::convert(buf.get(), size, byteOrder, ByteOrder::LittleEndian);
+        return decodeInt<T>(buf, size, byteOrder);
+    }
 
-        if (static_cast<std::size_t>(size) < sizeof(T)) {
-            memset(buf.get() + size, 0, sizeof(T) - size);
+    /**
+     * Reads an array of integer values.
+     *
+     * \param[in]  addr      Address of the first value.
+     * \param[in]  size      Size of each value.
+     * \param[in]  stride    Distance between the addresses of consecutive values.
+     * \param[in]  count     Number of values to read.
+     * \param[in]  byteOrder Byte order used for storing the integer values.
+     * \param[out] values    Valid pointer to an array of at least count values.
+     *
+     * \tparam T Result type. The values are truncated or zero-extended as by readInt().
+     *
+     * \return Number of values actually read. Reading stops at the first value that cannot be read.
+     */
+    template<class T>
+    std::size_t readInts(ByteAddr addr, ByteSize size, ByteSize stride, std::size_t count, ByteOrder byteOrder, T *values) const {
+        assert(size >= 0);
+        assert(byteOrder != ByteOrder::Unknown);
+        assert(count == 0 || values != nullptr);
+
+        if (count == 0) {
+            return 0;
         }
 
-        ByteOrder::convert(buf.get(), sizeof(T), ByteOrder::LittleEndian, ByteOrder::Current);
+        const char *span = nullptr;
+        if (0 <= stride && stride <= (std::numeric_limits<ByteSize>::max() - size) / static_cast<ByteSize>(count)) {
+            span = getSpan(addr, stride * static_cast<ByteSize>(count - 1) + size);
+        }
 
-        return *reinterpret_cast<T *>(buf.get());
+        if (span) {
+            switch (size) {
+                case 1: decodeInts<T, uint8_t>(span, stride, count, byteOrder, values); return count;
+                case 2: decodeInts<T, uint16_t>(span, stride, count, byteOrder, values); return count;
+                case 4: decodeInts<T, uint32_t>(span, stride, count, byteOrder, values); return count;
+                case 8: decodeInts<T, uint64_t>(span, stride, count, byteOrder, values); return count;
+                default:
+                    for (std::size_t i = 0; i < count; ++i) {
+                        values[i] = decodeInt<T>(span + stride * i, size, byteOrder);
+                    }
+                    return count;
+            }
+        }
+
+        for (std::size_t i = 0; i < count; ++i) {
+            auto value = readInt<T>(addr + stride * i, size, byteOrder);
+            if (!value) {
+                return i;
+            }
+            values[i] = *value;
+        }
+        return count;
     }
 
     /**
@@ -115,6 +181,72 @@ public:
      * \return ASCIIZ string without zero char terminator on success, nullptr string on failure.
      */
     QString readAsciizString(ByteAddr addr, ByteSize maxSize) const;
+
+private:
+    /**
+     * Decodes an integer value.
+     *
+     * \param[in] bytes     Valid pointer to the bytes of the value.
+     * \param[in] size      Size of the integer value.
+     * \param[in] byteOrder Byte order used for storing the integer value.
+     *
+     * \tparam T Result type.
+     *
+     * \return The integer value. If sizeof(T) < size, the lower bytes are returned.
+     *         If sizeof(T) > size, the value is zero-extended.
+     */
+    template<class T>
+    static T decodeInt(const char *bytes, ByteSize size, ByteOrder byteOrder) {
+        typedef typename std::make_unsigned<T>::type U;
+
+        U result = 0;
+        auto resultSize = std::min<ByteSize>(size, sizeof(T));
+
+        if (byteOrder == ByteOrder::LittleEndian) {
+            for (ByteSize i = 0; i < resultSize; ++i) {
+                result |= static_cast<U>(static_cast<unsigned char>(bytes[i])) << (i * CHAR_BIT);
+            }
+        } else {
+            for (ByteSize i = 0; i < resultSize; ++i) {
+                result |= static_cast<U>(static_cast<unsigned char>(bytes[size - 1 - i])) << (i * CHAR_BIT);
+            }
+        }
+
+        return static_cast<T>(result);
+    }
+
+    /**
+     * Decodes an array of integer values of a fixed size.
+     * The loops are simple enough for compilers to vectorize them,
+     * including the byte swaps.
+     *
+     * \param[in]  bytes     Valid pointer to the bytes of the first value.
+     * \param[in]  stride    Distance between the addresses of consecutive values.
+     * \param[in]  count     Number of values.
+     * \param[in]  byteOrder Byte order used for storing the integer values.
+     * \param[out] values    Valid pointer to an array of at least count values.
+     *
+     * \tparam T Result type.
+     * \tparam E Unsigned integer type of the size of a stored value.
+     */
+    template<class T, class E>
+    static void decodeInts(const char *bytes, ByteSize stride, std::size_t count, ByteOrder byteOrder, T *values) {
+        typedef typename std::make_unsigned<T>::type U;
+
+        if (byteOrder == ByteOrder::Current) {
+            for (std::size_t i = 0; i < count; ++i) {
+                E value;
+                memcpy(&value, bytes + stride * i, sizeof(value));
+                values[i] = static_cast<T>(static_cast<U>(value));
+            }
+        } else {
+            for (std::size_t i = 0; i < count; ++i) {
+                E value;
+                memcpy(&value, bytes + stride * i, sizeof(value));
+                values[i] = static_cast<T>(static_cast<U>(ByteOrder::swapBytes(value)));
+            }
+        }
+    }
 };
 
 } // namespace image
@@ -61,6 +61,22 @@ ByteSize Section::readBytes(ByteAddr addr, void *buf, ByteSize size) const {
     }
 }
 
+const char *Section::getSpan(ByteAddr addr, ByteSize size) const {
+    auto offset = addr - addr_;
+
+    if (offset < 0 || size < 0 || offset > size_ || size > size_ - offset) {
+        return nullptr;
+    }
+
+    if (externalByteSource()) {
+        return externalByteSource()->getSpan(addr, size);
+    } else if (offset + size <= content_.size()) {
+        return content_.constData() + offset;
+    } else {
+        return nullptr;
+    }
+}
+
 } // namespace image
 } // namespace core
 } // namespace nc
@@ -226,6 +226,14 @@ public:
      * If the array is smaller than the section, reading from beyond the array yields zeroes.
      */
     ByteSize readBytes(ByteAddr addr, void *buf, ByteSize size) const override;
+
+    /**
+     * Gives direct access to a sequence of bytes of the section.
+     * Delegates to the external byte source, if set.
+     * If not set, returns a pointer into the QByteArray given to setContent(),
+     * provided that the array covers the whole sequence.
+     */
+    const char *getSpan(ByteAddr addr, ByteSize size) const override;
 };
 
 } // namespace image
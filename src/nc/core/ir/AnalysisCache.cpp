@@ -0,0 +1,97 @@
+/* The file is part of Snowman decompiler. */
+/* See doc/licenses.asciidoc for the licensing information. */
+
+#include "AnalysisCache.h"
+
+#include <cassert>
+
+#include <nc/common/make_unique.h>
+
+#include <nc/core/ir/dflow/Uses.h>
+
+#include "CFG.h"
+#include "Dominators.h"
+#include "Function.h"
+
+namespace nc {
+namespace core {
+namespace ir {
+
+struct AnalysisCache::Entry {
+    /** Mutex guarding the fields below. */
+    std::mutex mutex;
+
+    std::unique_ptr<CFG> cfg;
+    std::unique_ptr<Dominators> dominators;
+
+    /** Dataflow information the uses were computed from. */
+    const dflow::Dataflow *dataflow;
+    std::unique_ptr<dflow::Uses> uses;
+
+    Entry(): dataflow(nullptr) {}
+};
+
+AnalysisCache::AnalysisCache() {}
+
+AnalysisCache::~AnalysisCache() {}
+
+AnalysisCache::Entry &AnalysisCache::getEntry(const Function *function) {
+    assert(function != nullptr);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto &entry = function2entry_[function];
+    if (!entry) {
+        entry = std::make_unique<Entry>();
+    }
+    return *entry;
+}
+
+const CFG &AnalysisCache::getCFG(const Function *function) {
+    auto &entry = getEntry(function);
+
+    std::lock_guard<std::mutex> lock(entry.mutex);
+
+    if (!entry.cfg) {
+        entry.cfg = std::make_unique<CFG>(function->basicBlocks());
+    }
+    return *entry.cfg;
+}
+
+const Dominators &AnalysisCache::getDominators(const Function *function, const CancellationToken &canceled) {
+    const auto &cfg = getCFG(function);
+    auto &entry = getEntry(function);
+
+    std::lock_guard<std::mutex> lock(entry.mutex);
+
+    if (!entry.dominators) {
+        entry.dominators = std::make_unique<Dominators>(cfg, canceled);
+    }
+    return *entry.dominators;
+}
+
+const dflow::Uses &AnalysisCache::getUses(const Function *function, const dflow::Dataflow &dataflow) {
+    auto &entry = getEntry(function);
+
+    std::lock_guard<std::mutex> lock(entry.mutex);
+
+    if (!entry.uses || entry.dataflow != &dataflow) {
+        entry.uses = std::make_unique<dflow::Uses>(dataflow);
+        entry.dataflow = &dataflow;
+    }
+    return *entry.uses;
+}
+
+void AnalysisCache::invalidate(const Function *function) {
+    assert(function != nullptr);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    function2entry_.erase(function);
+}
+
+} // namespace ir
+} // namespace core
+} // namespace nc
+
+/* vim:set et sts=4 sw=4: */
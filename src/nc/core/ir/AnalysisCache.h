@@ -0,0 +1,108 @@
+/* The file is part of Snowman decompiler. */
+/* See doc/licenses.asciidoc for the licensing information. */
+
+#pragma once
+
+#include <nc/config.h>
+
+#include <memory>
+#include <mutex>
+
+#include <boost/noncopyable.hpp>
+#include <boost/unordered_map.hpp>
+
+namespace nc {
+
+class CancellationToken;
+
+namespace core {
+namespace ir {
+
+class CFG;
+class Dominators;
+class Function;
+
+namespace dflow {
+    class Dataflow;
+    class Uses;
+}
+
+/**
+ * Per-function cache of analyses derived from the intermediate representation
+ * of a function: control flow graph, dominator tree, uses of definitions.
+ *
+ * The analyses are computed on first request and kept until the function
+ * is invalidated, which must happen every time the function's statements
+ * change, e.g. when the function is (re)instrumented with hooks.
+ *
+ * Different functions can be queried concurrently.
+ */
+class AnalysisCache: boost::noncopyable {
+    struct Entry;
+
+    /** Mutex guarding the mapping below, but not the entries. */
+    std::mutex mutex_;
+
+    /** Mapping from a function to its cached analyses. */
+    boost::unordered_map<const Function *, std::unique_ptr<Entry>> function2entry_;
+
+public:
+    /**
+     * Constructor.
+     */
+    AnalysisCache();
+
+    /**
+     * Destructor.
+     */
+    ~AnalysisCache();
+
+    /**
+     * \param function Valid pointer to a function.
+     *
+     * \return Control flow graph of the function.
+     *         The reference is valid until the function is invalidated.
+     */
+    const CFG &getCFG(const Function *function);
+
+    /**
+     * \param function Valid pointer to a function.
+     * \param canceled Cancellation token.
+     *
+     * \return Dominator tree of the function's control flow graph.
+     *         The reference is valid until the function is invalidated.
+     */
+    const Dominators &getDominators(const Function *function, const CancellationToken &canceled);
+
+    /**
+     * \param function Valid pointer to a function.
+     * \param dataflow Dataflow information of the function.
+     *
+     * \return Uses of definitions computed from the given dataflow information.
+     *         If the cached uses were computed from a different dataflow object,
+     *         they are recomputed. The reference is valid until the function
+     *         is invalidated or the uses are requested for another dataflow object.
+     */
+    const dflow::Uses &getUses(const Function *function, const dflow::Dataflow &dataflow);
+
+    /**
+     * Forgets all the analyses of the given function.
+     *
+     * \param function Valid pointer to a function.
+     */
+    void invalidate(const Function *function);
+
+private:
+    /**
+     * \param function Valid pointer to a function.
+     *
+     * \return Reference to the cache entry of the function, created if necessary.
+     */
+    Entry &getEntry(const Function *function);
+};
+
+} // namespace ir
+} // namespace core
+} // namespace nc
+
+/* vim:set et sts=4 sw=4: */
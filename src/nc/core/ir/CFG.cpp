@@ -26,10 +26,6 @@
 
 #include <QTextStream>
 
-#ifndef NDEBUG
-#include <boost/unordered_set.hpp>
-#endif
-
 #include <nc/common/Foreach.h>
 
 #include "BasicBlock.h"
@@ -43,51 +39,81 @@ namespace ir {
 CFG::CFG(const BasicBlocks &basicBlocks):
     basicBlocks_(basicBlocks)
 {
+    indexedBasicBlocks_.reserve(basicBlocks.size());
     foreach (const BasicBlock *basicBlock, basicBlocks) {
-        if (const Jump *jump = basicBlock->getJump()) {
-            addConnections(basicBlock, jump->thenTarget());
-            addConnections(basicBlock, jump->elseTarget());
-        }
+        indices_[basicBlock] = indexedBasicBlocks_.size();
+        indexedBasicBlocks_.push_back(basicBlock);
     }
 
-#ifndef NDEBUG
-    boost::unordered_set<const BasicBlock *> set(basicBlocks.begin(), basicBlocks.end());
-    foreach (auto &pair, predecessors_) {
-        assert(nc::contains(set, pair.first));
-        foreach (const BasicBlock *predecessor, pair.second) {
-            assert(nc::contains(set, predecessor));
+    const std::size_t size = indexedBasicBlocks_.size();
+
+    /* Edges as pairs of predecessor and successor indices, grouped by predecessor. */
+    std::vector<std::pair<std::size_t, std::size_t>> edges;
+
+    auto addConnection = [&](std::size_t predecessor, const BasicBlock *successor) {
+        auto i = indices_.find(successor);
+        assert(i != indices_.end());
+        if (i != indices_.end()) {
+            edges.push_back(std::make_pair(predecessor, i->second));
         }
-    }
-    foreach (auto &pair, successors_) {
-        assert(nc::contains(set, pair.first));
-        foreach (const BasicBlock *successor, pair.second) {
-            assert(nc::contains(set, successor));
+    };
+
+    auto addConnections = [&](std::size_t predecessor, const JumpTarget &jumpTarget) {
+        if (jumpTarget.basicBlock()) {
+            addConnection(predecessor, jumpTarget.basicBlock());
+        }
+        if (jumpTarget.table()) {
+            foreach (const JumpTableEntry &entry, *jumpTarget.table()) {
+                if (entry.basicBlock()) {
+                    addConnection(predecessor, entry.basicBlock());
+                }
+            }
+        }
+    };
+
+    for (std::size_t index = 0; index < size; ++index) {
+        if (const Jump *jump = indexedBasicBlocks_[index]->getJump()) {
+            addConnections(index, jump->thenTarget());
+            addConnections(index, jump->elseTarget());
         }
     }
-#endif
-}
 
-void CFG::addConnections(const BasicBlock *predecessor, const JumpTarget &jumpTarget) {
-    assert(predecessor);
+    /*
+     * Lay out the edges in compressed sparse row form. Adjacent blocks
+     * are kept in the order in which the edges were discovered.
+     */
+    successorOffsets_.assign(size + 1, 0);
+    predecessorOffsets_.assign(size + 1, 0);
 
-    if (jumpTarget.basicBlock()) {
-        addConnection(predecessor, jumpTarget.basicBlock());
+    foreach (const auto &edge, edges) {
+        ++successorOffsets_[edge.first + 1];
+        ++predecessorOffsets_[edge.second + 1];
     }
-    if (jumpTarget.table()) {
-        foreach (const JumpTableEntry &entry, *jumpTarget.table()) {
-            if (entry.basicBlock()) {
-                addConnection(predecessor, entry.basicBlock());
-            }
-        }
+    for (std::size_t index = 0; index < size; ++index) {
+        successorOffsets_[index + 1] += successorOffsets_[index];
+        predecessorOffsets_[index + 1] += predecessorOffsets_[index];
     }
-}
 
-void CFG::addConnection(const BasicBlock *predecessor, const BasicBlock *successor) {
-    assert(predecessor != nullptr);
-    assert(successor != nullptr);
+    successorIndices_.resize(edges.size());
+    predecessorIndices_.resize(edges.size());
+
+    std::vector<std::size_t> successorPositions(successorOffsets_.begin(), successorOffsets_.end() - 1);
+    std::vector<std::size_t> predecessorPositions(predecessorOffsets_.begin(), predecessorOffsets_.end() - 1);
 
-    successors_[predecessor].push_back(successor);
-    predecessors_[successor].push_back(predecessor);
+    foreach (const auto &edge, edges) {
+        successorIndices_[successorPositions[edge.first]++] = edge.second;
+        predecessorIndices_[predecessorPositions[edge.second]++] = edge.first;
+    }
+
+    successors_.reserve(edges.size());
+    foreach (auto index, successorIndices_) {
+        successors_.push_back(indexedBasicBlocks_[index]);
+    }
+
+    predecessors_.reserve(edges.size());
+    foreach (auto index, predecessorIndices_) {
+        predecessors_.push_back(indexedBasicBlocks_[index]);
+    }
 }
 
 void CFG::print(QTextStream &out) const {
@@ -95,9 +121,9 @@ void CFG::print(QTextStream &out) const {
         out << *basicBlock;
     }
 
-    foreach (auto &pair, successors_) {
-        foreach (const BasicBlock *successor, pair.second) {
-            out << "basicBlock" << pair.first << " -> basicBlock" << successor << ';' << endl;
+    for (std::size_t index = 0; index < indexedBasicBlocks_.size(); ++index) {
+        foreach (auto successor, getSuccessorIndices(index)) {
+            out << "basicBlock" << indexedBasicBlocks_[index] << " -> basicBlock" << indexedBasicBlocks_[successor] << ';' << endl;
         }
     }
 }
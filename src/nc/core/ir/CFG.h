@@ -26,8 +26,10 @@
 #include <nc/config.h>
 
 #include <cassert>
+#include <cstddef>
 #include <vector>
 
+#include <boost/range/iterator_range.hpp>
 #include <boost/unordered_map.hpp>
 
 #include <nc/common/Printable.h>
@@ -39,7 +41,6 @@ namespace core {
 namespace ir {
 
 class BasicBlock;
-class JumpTarget;
 
 /**
  * Control flow graph.
@@ -47,20 +48,50 @@ class JumpTarget;
  * Objects of this class can be constructed from a set of basic blocks
  * and contain information about the successors and predecessors of the
  * basic blocks.
+ *
+ * Basic blocks are numbered densely in the order of the set they come from.
+ * Successors and predecessors are stored in compressed sparse row form:
+ * the adjacent blocks of all blocks are concatenated in one array, and
+ * a second array gives the beginning of each block's part. Index-based
+ * accessors do not involve any hash lookups.
  */
 class CFG: public PrintableBase<CFG> {
 public:
     typedef nc::ilist<BasicBlock> BasicBlocks;
 
+    /** Range of pointers to basic blocks. */
+    typedef boost::iterator_range<std::vector<const BasicBlock *>::const_iterator> BasicBlockRange;
+
+    /** Range of indices of basic blocks. */
+    typedef boost::iterator_range<std::vector<std::size_t>::const_iterator> IndexRange;
+
 private:
     /** References to the set of basic blocks passed to the constructor. */
     const BasicBlocks &basicBlocks_;
 
-    /** Mapping from a basic block to the list of its successors. */
-    boost::unordered_map<const BasicBlock *, std::vector<const BasicBlock *>> successors_;
+    /** Basic blocks, by index. */
+    std::vector<const BasicBlock *> indexedBasicBlocks_;
+
+    /** Mapping from a basic block to its index. */
+    boost::unordered_map<const BasicBlock *, std::size_t> indices_;
+
+    /** Successors of block i are stored at [successorOffsets_[i], successorOffsets_[i + 1]). */
+    std::vector<std::size_t> successorOffsets_;
+
+    /** Indices of the successors of all blocks. */
+    std::vector<std::size_t> successorIndices_;
+
+    /** Successors of all blocks, laid out as successorIndices_. */
+    std::vector<const BasicBlock *> successors_;
+
+    /** Predecessors of block i are stored at [predecessorOffsets_[i], predecessorOffsets_[i + 1]). */
+    std::vector<std::size_t> predecessorOffsets_;
 
-    /** Mapping from a basic block to the list of its predecessors. */
-    boost::unordered_map<const BasicBlock *, std::vector<const BasicBlock *>> predecessors_;
+    /** Indices of the predecessors of all blocks. */
+    std::vector<std::size_t> predecessorIndices_;
+
+    /** Predecessors of all blocks, laid out as predecessorIndices_. */
+    std::vector<const BasicBlock *> predecessors_;
 
 public:
     /**
@@ -78,14 +109,45 @@ public:
      */
     const BasicBlocks &basicBlocks() const { return basicBlocks_; }
 
+    /**
+     * \return Number of basic blocks in the graph.
+     */
+    std::size_t basicBlockCount() const { return indexedBasicBlocks_.size(); }
+
+    /**
+     * \param[in] index Index of a basic block, less than basicBlockCount().
+     *
+     * \return Valid pointer to the basic block with this index.
+     */
+    const BasicBlock *getBasicBlock(std::size_t index) const {
+        assert(index < indexedBasicBlocks_.size());
+        return indexedBasicBlocks_[index];
+    }
+
+    /**
+     * \param[in] basicBlock Valid pointer to a basic block of the graph.
+     *
+     * \return Index of the basic block.
+     */
+    std::size_t getIndex(const BasicBlock *basicBlock) const {
+        assert(basicBlock != nullptr);
+        assert(nc::contains(indices_, basicBlock));
+        return nc::find(indices_, basicBlock);
+    }
+
     /**
      * \param[in] basicBlock Valid pointer to a basic block.
      *
      * \return List of successors of the basic block.
      */
-    const std::vector<const BasicBlock *> &getSuccessors(const BasicBlock *basicBlock) const {
+    BasicBlockRange getSuccessors(const BasicBlock *basicBlock) const {
         assert(basicBlock != nullptr);
-        return nc::find(successors_, basicBlock);
+        auto i = indices_.find(basicBlock);
+        if (i == indices_.end()) {
+            return BasicBlockRange(successors_.end(), successors_.end());
+        }
+        return BasicBlockRange(successors_.begin() + successorOffsets_[i->second],
+                               successors_.begin() + successorOffsets_[i->second + 1]);
     }
 
     /**
@@ -93,34 +155,44 @@ public:
      *
      * \return List of predecessors of the basic block.
      */
-    const std::vector<const BasicBlock *> &getPredecessors(const BasicBlock *basicBlock) const {
+    BasicBlockRange getPredecessors(const BasicBlock *basicBlock) const {
         assert(basicBlock != nullptr);
-        return nc::find(predecessors_, basicBlock);
+        auto i = indices_.find(basicBlock);
+        if (i == indices_.end()) {
+            return BasicBlockRange(predecessors_.end(), predecessors_.end());
+        }
+        return BasicBlockRange(predecessors_.begin() + predecessorOffsets_[i->second],
+                               predecessors_.begin() + predecessorOffsets_[i->second + 1]);
     }
 
     /**
-     * Prints the CFG in DOT format into a stream.
+     * \param[in] index Index of a basic block, less than basicBlockCount().
      *
-     * \param[in] out Output stream.
+     * \return Indices of the successors of the basic block.
      */
-    void print(QTextStream &out) const;
+    IndexRange getSuccessorIndices(std::size_t index) const {
+        assert(index < indexedBasicBlocks_.size());
+        return IndexRange(successorIndices_.begin() + successorOffsets_[index],
+                          successorIndices_.begin() + successorOffsets_[index + 1]);
+    }
 
-private:
     /**
-     * Adds an edge from a predecessor to a successor.
+     * \param[in] index Index of a basic block, less than basicBlockCount().
      *
-     * \param[in] predecessor Valid pointer to a predecessor basic block.
-     * \param[in] successor   Valid pointer to a successor basic block.
+     * \return Indices of the predecessors of the basic block.
      */
-    void addConnection(const BasicBlock *predecessor, const BasicBlock *successor);
+    IndexRange getPredecessorIndices(std::size_t index) const {
+        assert(index < indexedBasicBlocks_.size());
+        return IndexRange(predecessorIndices_.begin() + predecessorOffsets_[index],
+                          predecessorIndices_.begin() + predecessorOffsets_[index + 1]);
+    }
 
     /**
-     * Adds edges from a predecessor to all jump targets.
+     * Prints the CFG in DOT format into a stream.
      *
-     * \param[in] predecessor   Valid pointer to a basic block.
-     * \param[in] jumpTarget    Jump target of the predecessor's terminating jump.
+     * \param[in] out Output stream.
      */
-    void addConnections(const BasicBlock *predecessor, const JumpTarget &jumpTarget);
+    void print(QTextStream &out) const;
 };
 
 } // namespace ir
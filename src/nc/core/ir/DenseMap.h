@@ -0,0 +1,204 @@
+/* The file is part of Snowman decompiler. */
+/* See doc/licenses.asciidoc for the licensing information. */
+
+#pragma once
+
+#include <nc/config.h>
+
+#include <cassert>
+#include <cstddef>
+#include <deque>
+#include <utility>
+
+#include <boost/unordered_map.hpp>
+
+#include <nc/common/Foreach.h>
+
+namespace nc {
+namespace core {
+namespace ir {
+
+/**
+ * Mapping from terms or statements of a function to values.
+ *
+ * Values of keys having an index assigned by their function are stored
+ * in an array indexed by this index. Keys without an index (e.g. terms
+ * of basic blocks not belonging to any function) are stored in a hash map.
+ *
+ * \tparam Key Term or Statement.
+ * \tparam T Value type. Must be default-constructible.
+ */
+template<class Key, class T>
+class DenseMap {
+    /**
+     * Pairs of keys and values, indexed by key's index. Key is nullptr for unused slots.
+     * A deque does not move its elements when growing at the end, so references
+     * returned by operator[] stay valid when keys with larger indices are inserted
+     * (e.g. terms created by hooks in the middle of dataflow analysis).
+     */
+    std::deque<std::pair<const Key *, T>> slots_;
+
+    /** Values of keys that have no index or whose slot is taken by another key. */
+    boost::unordered_map<const Key *, T> others_;
+
+public:
+    /**
+     * \param key Valid pointer to a key.
+     *
+     * \return Reference to the value associated with the key.
+     *         If there is no such value, a default-constructed one is inserted.
+     *         The reference stays valid until the value is removed, the map is cleared,
+     *         or the key, inserted without an index, is given one.
+     */
+    T &operator[](const Key *key) {
+        assert(key != nullptr);
+
+        auto index = key->index();
+        if (index >= 0) {
+            if (static_cast<std::size_t>(index) >= slots_.size()) {
+                slots_.resize(index + 1);
+            }
+
+            auto &slot = slots_[index];
+            if (slot.first == key) {
+                return slot.second;
+            }
+            if (slot.first == nullptr) {
+                slot.first = key;
+
+                /* The key could have been inserted before it got the index. */
+                if (!others_.empty()) {
+                    auto i = others_.find(key);
+                    if (i != others_.end()) {
+                        slot.second = std::move(i->second);
+                        others_.erase(i);
+                    }
+                }
+                return slot.second;
+            }
+        }
+
+        return others_[key];
+    }
+
+    /**
+     * \param key Valid pointer to a key.
+     *
+     * \return Pointer to the value associated with the key, or nullptr if there is no such value.
+     */
+    T *find(const Key *key) {
+        return const_cast<T *>(static_cast<const DenseMap *>(this)->find(key));
+    }
+
+    /**
+     * \param key Valid pointer to a key.
+     *
+     * \return Pointer to the value associated with the key, or nullptr if there is no such value.
+     */
+    const T *find(const Key *key) const {
+        assert(key != nullptr);
+
+        auto index = key->index();
+        if (index >= 0 && static_cast<std::size_t>(index) < slots_.size() && slots_[index].first == key) {
+            return &slots_[index].second;
+        }
+        if (!others_.empty()) {
+            auto i = others_.find(key);
+            if (i != others_.end()) {
+                return &i->second;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * \param key Valid pointer to a key.
+     *
+     * \return Reference to the value associated with the key,
+     *         or to a default-constructed value if there is no such value.
+     */
+    const T &get(const Key *key) const {
+        static const T defaultValue = T();
+        auto result = find(key);
+        return result ? *result : defaultValue;
+    }
+
+    /**
+     * \param key Valid pointer to a key.
+     *
+     * \return True if a value is associated with the key, false otherwise.
+     */
+    bool contains(const Key *key) const { return find(key) != nullptr; }
+
+    /**
+     * Calls a function for each key-value pair.
+     * Keys having an index are visited in the order of their indices.
+     *
+     * \param function Function accepting a valid pointer to a key and a reference to the value.
+     */
+    template<class Function>
+    void forEach(Function function) {
+        foreach (auto &slot, slots_) {
+            if (slot.first) {
+                function(slot.first, slot.second);
+            }
+        }
+        foreach (auto &keyAndValue, others_) {
+            function(keyAndValue.first, keyAndValue.second);
+        }
+    }
+
+    /**
+     * Calls a function for each key-value pair.
+     * Keys having an index are visited in the order of their indices.
+     *
+     * \param function Function accepting a valid pointer to a key and a const reference to the value.
+     */
+    template<class Function>
+    void forEach(Function function) const {
+        foreach (const auto &slot, slots_) {
+            if (slot.first) {
+                function(slot.first, slot.second);
+            }
+        }
+        foreach (const auto &keyAndValue, others_) {
+            function(keyAndValue.first, keyAndValue.second);
+        }
+    }
+
+    /**
+     * Removes all the key-value pairs for which the predicate returns true.
+     *
+     * \param pred Predicate accepting a valid pointer to a key.
+     */
+    template<class Predicate>
+    void removeIf(Predicate pred) {
+        foreach (auto &slot, slots_) {
+            if (slot.first && pred(slot.first)) {
+                slot.first = nullptr;
+                slot.second = T();
+            }
+        }
+        for (auto i = others_.begin(); i != others_.end();) {
+            if (pred(i->first)) {
+                i = others_.erase(i);
+            } else {
+                ++i;
+            }
+        }
+    }
+
+    /**
+     * Removes all the key-value pairs.
+     */
+    void clear() {
+        slots_.clear();
+        others_.clear();
+    }
+};
+
+} // namespace ir
+} // namespace core
+} // namespace nc
+
+/* vim:set et sts=4 sw=4: */
@@ -3,6 +3,8 @@
 
 #include "Dominators.h"
 
+#include <algorithm>
+
 #include <nc/common/CancellationToken.h>
 #include <nc/common/Foreach.h>
 
@@ -14,58 +16,167 @@ namespace core {
 namespace ir {
 
 Dominators::Dominators(const CFG &cfg, const CancellationToken &canceled) {
+    /* Blocks have the same indices as in the control flow graph. */
+    const std::size_t size = cfg.basicBlockCount();
+
+    basicBlocks_.reserve(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        indices_[cfg.getBasicBlock(i)] = i;
+        basicBlocks_.push_back(cfg.getBasicBlock(i));
+    }
+
     /*
-     * Each node dominates itself.
+     * Number the blocks in depth-first postorder, starting from the blocks
+     * without predecessors, and then from the blocks not visited yet.
+     * The blocks from which the searches start get a virtual root
+     * as their only extra predecessor.
      */
-    foreach (auto basicBlock, cfg.basicBlocks()) {
-        dominators_[basicBlock].push_back(basicBlock);
+    const std::size_t unvisited = -1;
+    std::vector<std::size_t> postorderNumbers(size, unvisited);
+    std::vector<std::size_t> order; // Blocks in postorder.
+    std::vector<char> isRoot(size, false);
+    order.reserve(size);
+
+    {
+        std::vector<char> visited(size, false);
+        std::vector<std::pair<std::size_t, std::size_t>> stack; // Block and the index of its next successor.
+
+        auto search = [&](std::size_t start) {
+            isRoot[start] = true;
+            visited[start] = true;
+            stack.push_back(std::make_pair(start, 0));
+
+            while (!stack.empty()) {
+                auto block = stack.back().first;
+                auto successors = cfg.getSuccessorIndices(block);
+
+                if (stack.back().second < static_cast<std::size_t>(successors.size())) {
+                    auto successor = successors[stack.back().second++];
+                    if (!visited[successor]) {
+                        visited[successor] = true;
+                        stack.push_back(std::make_pair(successor, 0));
+                    }
+                } else {
+                    postorderNumbers[block] = order.size();
+                    order.push_back(block);
+                    stack.pop_back();
+                }
+            }
+        };
+
+        for (std::size_t i = 0; i < size; ++i) {
+            if (!visited[i] && cfg.getPredecessorIndices(i).empty()) {
+                search(i);
+            }
+        }
+        for (std::size_t i = 0; i < size; ++i) {
+            if (!visited[i]) {
+                search(i);
+            }
+        }
     }
 
     /*
-     * Recompute dominator sets until fixpoint.
+     * Compute immediate dominators. The virtual root has index size.
      */
+    const std::size_t root = size;
+    const std::size_t undefined = -1;
+
+    std::vector<std::size_t> idoms(size, undefined);
+
+    auto postorderNumber = [&](std::size_t block) {
+        return block == root ? size : postorderNumbers[block];
+    };
+
+    auto intersect = [&](std::size_t a, std::size_t b) {
+        while (a != b) {
+            while (postorderNumber(a) < postorderNumber(b)) {
+                a = idoms[a];
+            }
+            while (postorderNumber(b) < postorderNumber(a)) {
+                b = idoms[b];
+            }
+        }
+        return a;
+    };
+
     bool changed;
     do {
         changed = false;
 
-        foreach (auto basicBlock, cfg.basicBlocks()) {
-            const auto &predecessors = cfg.getPredecessors(basicBlock);
+        /* Visit the blocks in reverse postorder. */
+        for (auto i = order.rbegin(); i != order.rend(); ++i) {
+            auto block = *i;
+            auto newIdom = isRoot[block] ? root : undefined;
 
-            if (!predecessors.empty()) {
-                boost::unordered_map<const BasicBlock *, std::size_t> intersection;
-                foreach (auto predecessor, predecessors) {
-                    foreach (auto predDominator, dominators_[predecessor]) {
-                        ++intersection[predDominator];
-                    }
+            foreach (auto p, cfg.getPredecessorIndices(block)) {
+                if (idoms[p] != undefined) {
+                    newIdom = newIdom == undefined ? p : intersect(p, newIdom);
                 }
-                intersection.erase(basicBlock);
+            }
 
-                std::vector<const BasicBlock *> newDominators;
-                foreach (const auto &pair, intersection) {
-                    if (pair.second == predecessors.size()) {
-                        newDominators.push_back(pair.first);
-                    }
-                }
-                newDominators.push_back(basicBlock);
-
-                auto &oldDominators = dominators_[basicBlock];
-                /* Sets grow monotonically, so we can just compare sizes. */
-                if (newDominators.size() != oldDominators.size()) {
-                    assert(newDominators.size() > oldDominators.size());
-                    oldDominators = std::move(newDominators);
-                    changed = true;
-                }
+            if (newIdom != idoms[block]) {
+                idoms[block] = newIdom;
+                changed = true;
             }
         }
 
         canceled.poll();
     } while (changed);
 
-    foreach (auto &pair, dominators_) {
-        std::sort(pair.second.begin(), pair.second.end());
+    /*
+     * Number the nodes of the dominator tree in pre- and postorder.
+     */
+    immediateDominators_.resize(size);
+    std::vector<std::vector<std::size_t>> children(size + 1);
+
+    for (auto i = order.rbegin(); i != order.rend(); ++i) {
+        auto block = *i;
+        assert(idoms[block] != undefined);
+
+        immediateDominators_[block] = idoms[block] == root ? -1 : static_cast<std::ptrdiff_t>(idoms[block]);
+        children[idoms[block]].push_back(block);
+    }
+
+    preorder_.resize(size);
+    postorder_.resize(size);
+
+    std::size_t nextPreorderNumber = 0;
+    std::size_t nextPostorderNumber = 0;
+    std::vector<std::pair<std::size_t, std::size_t>> stack; // Node and the index of its next child.
+
+    stack.push_back(std::make_pair(root, 0));
+    while (!stack.empty()) {
+        auto node = stack.back().first;
+        const auto &nodeChildren = children[node];
+
+        if (stack.back().second < nodeChildren.size()) {
+            auto child = nodeChildren[stack.back().second++];
+            preorder_[child] = nextPreorderNumber++;
+            stack.push_back(std::make_pair(child, 0));
+        } else {
+            if (node != root) {
+                postorder_[node] = nextPostorderNumber++;
+            }
+            stack.pop_back();
+        }
     }
 }
 
+std::vector<const BasicBlock *> Dominators::getDominators(const BasicBlock *basicBlock) const {
+    std::vector<const BasicBlock *> result;
+
+    std::ptrdiff_t index = getIndex(basicBlock);
+    while (index >= 0) {
+        result.push_back(basicBlocks_[index]);
+        index = immediateDominators_[index];
+    }
+
+    std::sort(result.begin(), result.end());
+
+    return result;
+}
+
 } // namespace ir
 } // namespace core
 } // namespace nc
@@ -5,6 +5,8 @@
 
 #include <nc/config.h>
 
+#include <cassert>
+#include <cstddef>
 #include <vector>
 
 #include <boost/unordered_map.hpp>
@@ -22,16 +24,32 @@ class BasicBlock;
 class CFG;
 
 /**
- * Dominator sets.
+ * Dominator tree.
+ *
+ * Blocks having no predecessors are the roots of the tree. A block
+ * unreachable from such blocks (e.g. lying on an unreachable cycle)
+ * becomes a root when it is first encountered.
  */
 class Dominators {
-    /** Mapping from a basic block to the set of its dominators. */
-    boost::unordered_map<const BasicBlock *, std::vector<const BasicBlock *>> dominators_;
+    /** Mapping from a basic block to its index. */
+    boost::unordered_map<const BasicBlock *, std::size_t> indices_;
+
+    /** Basic blocks, by index. */
+    std::vector<const BasicBlock *> basicBlocks_;
+
+    /** Index of the immediate dominator of each block, or -1 for the roots of the tree. */
+    std::vector<std::ptrdiff_t> immediateDominators_;
+
+    /** Preorder numbers of the blocks in the dominator tree. */
+    std::vector<std::size_t> preorder_;
+
+    /** Postorder numbers of the blocks in the dominator tree. */
+    std::vector<std::size_t> postorder_;
 
 public:
     /**
-     * Constructs dominator sets from the control flow graph.
-     * Uses classic iterative algorithm for that.
+     * Constructs the dominator tree of the control flow graph.
+     * Uses the iterative algorithm of Cooper, Harvey, and Kennedy for that.
      *
      * \param cfg Control flow graph.
      * \param canceled Cancellation token.
@@ -41,14 +59,23 @@ public:
     /**
      * \param basicBlock Valid pointer to a basic block.
      *
-     * \return The set of dominators of this basic block.
+     * \return Pointer to the immediate dominator of the basic block.
+     *         nullptr if the block is a root of the dominator tree.
      */
-    const std::vector<const BasicBlock *> &getDominators(const BasicBlock *basicBlock) const {
-        assert(basicBlock != nullptr);
-        assert(nc::contains(dominators_, basicBlock));
-        return nc::find(dominators_, basicBlock);
+    const BasicBlock *getImmediateDominator(const BasicBlock *basicBlock) const {
+        auto index = getIndex(basicBlock);
+        return immediateDominators_[index] >= 0 ? basicBlocks_[immediateDominators_[index]] : nullptr;
     }
 
+    /**
+     * \param basicBlock Valid pointer to a basic block.
+     *
+     * \return The set of dominators of this basic block, sorted by pointer.
+     *
+     * \note The set is computed on every call in time proportional to its size.
+     */
+    std::vector<const BasicBlock *> getDominators(const BasicBlock *basicBlock) const;
+
     /**
      * \param dominating Valid pointer to a basic block.
      * \param dominated Valid pointer to a basic block.
@@ -56,13 +83,22 @@ public:
      * \return True of dominating dominates dominated.
      */
     bool isDominating(const BasicBlock *dominating, const BasicBlock *dominated) const {
-        assert(dominating != nullptr);
-        assert(nc::contains(dominators_, dominating));
-        assert(dominated != nullptr);
-        assert(nc::contains(dominators_, dominated));
+        auto i = getIndex(dominating);
+        auto j = getIndex(dominated);
+
+        return preorder_[i] <= preorder_[j] && postorder_[j] <= postorder_[i];
+    }
 
-        const auto &dominators = getDominators(dominated);
-        return std::binary_search(dominators.begin(), dominators.end(), dominating);
+private:
+    /**
+     * \param basicBlock Valid pointer to a basic block of the control flow graph.
+     *
+     * \return Index of the basic block.
+     */
+    std::size_t getIndex(const BasicBlock *basicBlock) const {
+        assert(basicBlock != nullptr);
+        assert(nc::contains(indices_, basicBlock));
+        return nc::find(indices_, basicBlock);
     }
 };
 
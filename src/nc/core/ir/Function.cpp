@@ -24,12 +24,15 @@
 
 #include "Function.h"
 
+#include <functional>
+
 #include <QTextStream>
 
 #include <nc/common/Foreach.h>
 
 #include "BasicBlock.h"
 #include "CFG.h"
+#include "Jump.h"
 #include "Statements.h"
 #include "Term.h"
 
@@ -37,15 +40,59 @@ namespace nc {
 namespace core {
 namespace ir {
 
-Function::Function(): entry_(nullptr) {}
+Function::Function(): entry_(nullptr), statementCount_(0), termCount_(0) {}
 
 Function::~Function() {}
 
 void Function::addBasicBlock(std::unique_ptr<BasicBlock> basicBlock) {
     basicBlock->setFunction(this);
+    foreach (auto statement, basicBlock->statements()) {
+        assignIndices(statement);
+    }
     basicBlocks_.push_back(std::move(basicBlock));
 }
 
+void Function::assignIndices(Statement *statement) {
+    assert(statement != nullptr);
+
+    if (statement->index() < 0) {
+        statement->setIndex(statementCount_++);
+    }
+
+    std::function<void(Term *)> assign = [&](Term *term) {
+        if (term) {
+            if (term->index() < 0) {
+                term->setIndex(termCount_++);
+            }
+            term->callOnChildren(assign);
+        }
+    };
+
+    switch (statement->kind()) {
+        case Statement::ASSIGNMENT: {
+            auto assignment = statement->as<Assignment>();
+            assign(assignment->left());
+            assign(assignment->right());
+            break;
+        }
+        case Statement::JUMP: {
+            auto jump = statement->as<Jump>();
+            assign(jump->condition());
+            assign(jump->thenTarget().address());
+            assign(jump->elseTarget().address());
+            break;
+        }
+        case Statement::CALL:
+            assign(statement->as<Call>()->target());
+            break;
+        case Statement::TOUCH:
+            assign(statement->as<Touch>()->term());
+            break;
+        default:
+            break;
+    }
+}
+
 bool Function::isEmpty() const {
     foreach (auto basicBlock, basicBlocks()) {
         if (!basicBlock->statements().empty()) {
@@ -30,6 +30,7 @@
 
 #include <boost/noncopyable.hpp>
 
+#include <nc/common/Arena.h>
 #include <nc/common/Printable.h>
 #include <nc/common/ilist.h>
 
@@ -38,6 +39,8 @@ namespace core {
 namespace ir {
 
 class BasicBlock;
+class Statement;
+class Term;
 
 /**
  * Intermediate representation of a function.
@@ -48,7 +51,10 @@ public:
 
 private:
     BasicBlock *entry_; ///< Entry basic block.
+    Arena arena_; ///< Arena for the terms and statements of the function. Must outlive them.
     BasicBlocks basicBlocks_; ///< All basic blocks of the function.
+    int statementCount_; ///< Number of statement indices given out.
+    int termCount_; ///< Number of term indices given out.
 
 public:
     /**
@@ -101,6 +107,37 @@ public:
      */
     void addBasicBlock(std::unique_ptr<BasicBlock> basicBlock);
 
+    /**
+     * \return Arena for allocating the terms and statements of the function.
+     *
+     * \note Objects allocated in the arena must not be moved to other functions.
+     */
+    Arena &arena() { return arena_; }
+
+    /**
+     * \return Arena for allocating the terms and statements of the function.
+     */
+    const Arena &arena() const { return arena_; }
+
+    /**
+     * Assigns indices to the statement and its terms, unless they already have them.
+     *
+     * \param statement Valid pointer to a statement of one of the function's basic blocks.
+     *
+     * \note Called automatically when a statement or a basic block is added to the function.
+     */
+    void assignIndices(Statement *statement);
+
+    /**
+     * \return Upper bound on the indices of the statements of the function.
+     */
+    int statementCount() const { return statementCount_; }
+
+    /**
+     * \return Upper bound on the indices of the terms of the function.
+     */
+    int termCount() const { return termCount_; }
+
     /**
      * \return True iff this function has no statements in its basic blocks.
      */
@@ -25,7 +25,6 @@
 #include "FunctionsGenerator.h"
 
 #include <boost/range/adaptor/map.hpp>
-#include <boost/unordered_set.hpp>
 
 #include <nc/common/Foreach.h>
 #include <nc/common/Range.h>
@@ -46,18 +45,36 @@ namespace ir {
 
 namespace {
 
-void dfs(
-    const CFG &cfg,
-    const BasicBlock *basicBlock,
-    boost::unordered_set<const BasicBlock *> &visited,
-    std::vector<const BasicBlock *> &trace)
-{
-    visited.insert(basicBlock);
-    trace.push_back(basicBlock);
-
-    foreach (const BasicBlock *successor, cfg.getSuccessors(basicBlock)) {
-        if (visited.find(successor) == visited.end()) {
-            dfs(cfg, successor, visited, trace);
+/**
+ * Collects the basic blocks reachable from the given one in depth-first preorder.
+ *
+ * \param cfg Control flow graph.
+ * \param start Index of the basic block to start from.
+ * \param visit Function taking the index of a basic block, marking it as visited,
+ *              and returning true if it was not visited before.
+ * \param trace Vector to append the visited basic blocks to.
+ */
+template<class Visit>
+void dfs(const CFG &cfg, std::size_t start, Visit visit, std::vector<const BasicBlock *> &trace) {
+    std::vector<std::pair<std::size_t, std::size_t>> stack; // Block and the index of its next successor.
+
+    if (!visit(start)) {
+        return;
+    }
+    trace.push_back(cfg.getBasicBlock(start));
+    stack.push_back(std::make_pair(start, 0));
+
+    while (!stack.empty()) {
+        auto successors = cfg.getSuccessorIndices(stack.back().first);
+
+        if (stack.back().second < static_cast<std::size_t>(successors.size())) {
+            auto successor = successors[stack.back().second++];
+            if (visit(successor)) {
+                trace.push_back(cfg.getBasicBlock(successor));
+                stack.push_back(std::make_pair(successor, 0));
+            }
+        } else {
+            stack.pop_back();
         }
     }
 }
@@ -65,8 +82,6 @@ void dfs(
 } // anonymous namespace
 
 void FunctionsGenerator::makeFunctions(const Program &program, Functions &functions) const {
-    boost::unordered_set<const BasicBlock *> processed;
-
     CFG cfg(program.basicBlocks());
 
     auto addFunction = [&](const std::vector<const BasicBlock *> basicBlocks, const BasicBlock *entry) {
@@ -94,34 +109,60 @@ void FunctionsGenerator::makeFunctions(const Program &program, Functions &functi
         functions.addFunction(std::move(function));
     };
 
-    /* Generate all functions being called. */
-    foreach (const BasicBlock *basicBlock, program.basicBlocks()) {
-        if (basicBlock->address() && program.isCalledAddress(*basicBlock->address())) {
-            boost::unordered_set<const BasicBlock *> visited;
-            std::vector<const BasicBlock *> trace;
+    /* Blocks already included into the functions singled out below. */
+    std::vector<char> processed(cfg.basicBlockCount(), false);
 
-            dfs(cfg, basicBlock, visited, trace);
-            addFunction(trace, basicBlock);
-            processed.insert(trace.begin(), trace.end());
+    auto visitUnprocessed = [&](std::size_t index) -> bool {
+        if (processed[index]) {
+            return false;
+        }
+        processed[index] = true;
+        return true;
+    };
+
+    /* Generate all functions being called. */
+    {
+        /* Blocks visited by the search with the same mark are visited by the current search. */
+        std::vector<std::size_t> marks(cfg.basicBlockCount(), 0);
+        std::size_t mark = 0;
+
+        for (std::size_t index = 0; index < cfg.basicBlockCount(); ++index) {
+            auto basicBlock = cfg.getBasicBlock(index);
+            if (basicBlock->address() && program.isCalledAddress(*basicBlock->address())) {
+                std::vector<const BasicBlock *> trace;
+
+                ++mark;
+                dfs(cfg, index, [&](std::size_t i) -> bool {
+                    if (marks[i] == mark) {
+                        return false;
+                    }
+                    marks[i] = mark;
+                    processed[i] = true;
+                    return true;
+                }, trace);
+                addFunction(trace, basicBlock);
+            }
         }
     }
 
     /* Single out all other possible functions. */
-    foreach (const BasicBlock *basicBlock, program.basicBlocks()) {
-        if (basicBlock->address() && cfg.getPredecessors(basicBlock).empty() && !contains(processed, basicBlock)) {
+    for (std::size_t index = 0; index < cfg.basicBlockCount(); ++index) {
+        auto basicBlock = cfg.getBasicBlock(index);
+        if (basicBlock->address() && cfg.getPredecessorIndices(index).empty() && !processed[index]) {
             std::vector<const BasicBlock *> trace;
 
-            dfs(cfg, basicBlock, processed, trace);
+            dfs(cfg, index, visitUnprocessed, trace);
             addFunction(trace, basicBlock);
         }
     }
 
     /* Single out remaining weird strongly connected components. */
-    foreach (const BasicBlock *basicBlock, program.basicBlocks()) {
-        if (basicBlock->address() && !contains(processed, basicBlock)) {
+    for (std::size_t index = 0; index < cfg.basicBlockCount(); ++index) {
+        auto basicBlock = cfg.getBasicBlock(index);
+        if (basicBlock->address() && !processed[index]) {
             std::vector<const BasicBlock *> trace;
 
-            dfs(cfg, basicBlock, processed, trace);
+            dfs(cfg, index, visitUnprocessed, trace);
             addFunction(trace, basicBlock);
         }
     }
@@ -152,12 +193,16 @@ FunctionsGenerator::cloneIntoFunction(const std::vector<const BasicBlock *> &bas
     BasicBlockMap clones;
 
     /*
-     * Clone basic blocks.
+     * Clone basic blocks. Terms and statements go to the function's arena.
      */
-    foreach (const BasicBlock *basicBlock, basicBlocks) {
-        auto clone = basicBlock->clone();
-        clones[basicBlock] = clone.get();
-        function->addBasicBlock(std::move(clone));
+    {
+        Arena::Scope scope(&function->arena());
+
+        foreach (const BasicBlock *basicBlock, basicBlocks) {
+            auto clone = basicBlock->clone();
+            clones[basicBlock] = clone.get();
+            function->addBasicBlock(std::move(clone));
+        }
     }
 
     /*
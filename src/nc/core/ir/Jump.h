@@ -66,6 +66,11 @@ public:
      */
     Jump(JumpTarget thenTarget);
 
+    /**
+     * \return Pointer to the term representing jump condition, nullptr for unconditional jump.
+     */
+    Term *condition() { return condition_.get(); }
+
     /**
      * \return Pointer to the term representing jump condition, nullptr for unconditional jump.
      */
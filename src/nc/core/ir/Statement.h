@@ -32,6 +32,7 @@
 
 #include <QString>
 
+#include <nc/common/Arena.h>
 #include <nc/common/Printable.h>
 #include <nc/common/Subclass.h>
 #include <nc/common/ilist.h>
@@ -58,7 +59,7 @@ class Touch;
 /**
  * Base class for different kinds of statements of intermediate representation.
  */
-class Statement: public Printable, public nc::ilist_item, boost::noncopyable {
+class Statement: public Printable, public ArenaAllocated, public nc::ilist_item, boost::noncopyable {
     NC_BASE_CLASS(Statement, kind)
 
 public:
@@ -80,6 +81,7 @@ public:
 private:
     BasicBlock *basicBlock_; ///< Basic block to which this statement belongs.
     const arch::Instruction *instruction_; ///< Instruction from which this statement was generated.
+    int index_; ///< Index of the statement in its function, or -1 if not assigned.
 
 public:
     /**
@@ -87,7 +89,7 @@ public:
      *
      * \param[in] kind Kind of the statement.
      */
-    explicit Statement(int kind): kind_(kind), basicBlock_(nullptr), instruction_(nullptr) {}
+    explicit Statement(int kind): kind_(kind), basicBlock_(nullptr), instruction_(nullptr), index_(-1) {}
 
     /**
      * \return Pointer to the basic block to which this statement belongs.
@@ -108,6 +110,22 @@ public:
      */
     void setBasicBlock(BasicBlock *basicBlock) { basicBlock_ = basicBlock; }
 
+    /**
+     * \return Index of the statement among the statements of the function it belongs to,
+     *         or -1 if no index was assigned. Indices are dense and can be used
+     *         for storing per-statement information in arrays.
+     */
+    int index() const { return index_; }
+
+    /**
+     * Sets the index of the statement in its function.
+     *
+     * \param index Nonnegative index.
+     *
+     * \note Called by Function when the statement is added to it.
+     */
+    void setIndex(int index) { assert(index >= 0); index_ = index; }
+
     /**
      * \param[in] instruction Instruction from which this statement was generated.
      */
@@ -30,6 +30,7 @@
 
 #include <boost/noncopyable.hpp>
 
+#include <nc/common/Arena.h>
 #include <nc/common/Printable.h>
 #include <nc/common/Subclass.h>
 #include <nc/common/Types.h>
@@ -52,7 +53,7 @@ class Statement;
 /**
  * Base class for different kinds of expressions of intermediate representation.
  */
-class Term: public Printable, boost::noncopyable {
+class Term: public Printable, public ArenaAllocated, boost::noncopyable {
     NC_BASE_CLASS(Term, kind)
 
 public:
@@ -79,6 +80,7 @@ public:
 private:
     const Statement *statement_; ///< Statement that this term belongs to.
     SmallBitSize size_; ///< Size of this term's value in bits.
+    int index_; ///< Index of the term in its function, or -1 if not assigned.
 
 public:
     /**
@@ -88,7 +90,7 @@ public:
      * \param[in] size Size of this term's value in bits.
      */
     Term(int kind, SmallBitSize size):
-        kind_(kind), statement_(nullptr), size_(size)
+        kind_(kind), statement_(nullptr), size_(size), index_(-1)
     {
         assert(size != 0);
     }
@@ -112,6 +114,22 @@ public:
      */
     void setStatement(const Statement *statement);
 
+    /**
+     * \return Index of the term among the terms of the function it belongs to,
+     *         or -1 if no index was assigned. Indices are dense and can be used
+     *         for storing per-term information in arrays.
+     */
+    int index() const { return index_; }
+
+    /**
+     * Sets the index of the term in its function.
+     *
+     * \param index Nonnegative index.
+     *
+     * \note Called by Function when the term's statement is added to it.
+     */
+    void setIndex(int index) { assert(index >= 0); index_ = index; }
+
     /**
      * \return Term's access type.
      */
@@ -25,6 +25,7 @@
 #include "Hooks.h"
 
 #include <cassert>
+#include <utility>
 
 #include <nc/common/Foreach.h>
 #include <nc/common/Range.h>
@@ -57,10 +58,100 @@ Hooks::Hooks(const Conventions &conventions, const Signatures &signatures):
 
 Hooks::~Hooks() {}
 
+namespace {
+
+/**
+ * \param mutex Mutex guarding the mapping.
+ * \param map Mapping.
+ * \param key Key.
+ *
+ * \return The value mapped to the key, or a default-constructed value if there is none.
+ */
+template<class Map, class Key>
+typename Map::mapped_type findLocked(std::mutex &mutex, const Map &map, const Key &key) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return nc::find(map, key);
+}
+
+/**
+ * Maps the key to the given value.
+ *
+ * \param mutex Mutex guarding the mapping.
+ * \param map Mapping.
+ * \param key Key.
+ * \param value New value.
+ *
+ * \return The value previously mapped to the key, or a default-constructed value if there was none.
+ */
+template<class Map, class Key>
+typename Map::mapped_type exchangeLocked(std::mutex &mutex, Map &map, const Key &key, typename Map::mapped_type value) {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::swap(map[key], value);
+    return value;
+}
+
+/**
+ * Removes the key from the mapping.
+ *
+ * \param mutex Mutex guarding the mapping.
+ * \param map Mapping.
+ * \param key Key.
+ *
+ * \return The value mapped to the key, or a default-constructed value if there was none.
+ */
+template<class Map, class Key>
+typename Map::mapped_type takeLocked(std::mutex &mutex, Map &map, const Key &key) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto i = map.find(key);
+    if (i == map.end()) {
+        return typename Map::mapped_type();
+    }
+    auto result = i->second;
+    map.erase(i);
+    return result;
+}
+
+/**
+ * Finds the hook with the given key, creating it if necessary.
+ *
+ * The hook is created without holding the mutex. This is safe, because
+ * a key includes the function or the statement being instrumented, and
+ * a function is instrumented by one thread at a time.
+ *
+ * \param mutex Mutex guarding the mapping.
+ * \param hooks Mapping from keys to all hooks ever created.
+ * \param key Key of the hook.
+ * \param create Function creating the hook.
+ *
+ * \return Valid pointer to the hook.
+ */
+template<class Map, class Key, class Create>
+typename Map::mapped_type::element_type *getHook(std::mutex &mutex, Map &hooks, const Key &key, Create create) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto i = hooks.find(key);
+        if (i != hooks.end()) {
+            return i->second.get();
+        }
+    }
+
+    auto hook = create();
+    auto result = hook.get();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    hooks[key] = std::move(hook);
+    return result;
+}
+
+} // anonymous namespace
+
 const Convention *Hooks::getConvention(const CalleeId &calleeId) const {
     if (!calleeId) {
         return nullptr;
     }
+
+    std::lock_guard<std::mutex> lock(conventionsMutex_);
+
     if (auto result = conventions_.getConvention(calleeId)) {
         return result;
     } else {
@@ -69,22 +160,27 @@ const Convention *Hooks::getConvention(const CalleeId &calleeId) const {
     }
 }
 
+boost::optional<ByteSize> Hooks::getStackArgumentsSize(const CalleeId &calleeId) const {
+    std::lock_guard<std::mutex> lock(conventionsMutex_);
+    return conventions_.getStackArgumentsSize(calleeId);
+}
+
 const EntryHook *Hooks::getEntryHook(const Function *function) const {
     assert(function != nullptr);
 
-    return nc::find(lastEntryHooks_, function);
+    return findLocked(entryHooksMutex_, lastEntryHooks_, function);
 }
 
 const CallHook *Hooks::getCallHook(const Call *call) const {
     assert(call != nullptr);
 
-    return nc::find(lastCallHooks_, call);
+    return findLocked(callHooksMutex_, lastCallHooks_, call);
 }
 
 const ReturnHook *Hooks::getReturnHook(const Jump *jump) const {
     assert(jump != nullptr);
 
-    return nc::find(lastReturnHooks_, jump);
+    return findLocked(returnHooksMutex_, lastReturnHooks_, jump);
 }
 
 void Hooks::instrument(Function *function, const dflow::Dataflow *dataflow) {
@@ -93,26 +189,34 @@ void Hooks::instrument(Function *function, const dflow::Dataflow *dataflow) {
 
     deinstrument(function);
 
+    /*
+     * The callbacks are executed by the dataflow analysis of this function.
+     * Only the thread analyzing the function accesses its dataflow information,
+     * so the callbacks inspect it without holding any locks.
+     */
     if (function->entry()) {
-        function2callback_[function] = function->entry()->pushFront(std::make_unique<Callback>([=](){
+        auto callback = function->entry()->pushFront(std::make_unique<Callback>([=](){
             instrumentEntry(function);
         }));
+        exchangeLocked(entryHooksMutex_, function2callback_, function, callback);
     }
 
     foreach (auto basicBlock, function->basicBlocks()) {
         foreach (auto statement, basicBlock->statements()) {
             if (auto call = statement->as<Call>()) {
-                call2callback_[call] = basicBlock->insertAfter(call, std::make_unique<Callback>([=](){
+                auto callback = basicBlock->insertAfter(call, std::make_unique<Callback>([=](){
                     instrumentCall(call, *dataflow);
                 }));
+                exchangeLocked(callHooksMutex_, call2callback_, call, callback);
             } else if (auto jump = statement->as<Jump>()) {
-                jump2callback_[jump] = basicBlock->insertBefore(jump, std::make_unique<Callback>([=](){
+                auto callback = basicBlock->insertBefore(jump, std::make_unique<Callback>([=](){
                     if (dflow::isReturn(jump, *dataflow)) {
                         instrumentReturn(jump);
                     } else {
                         deinstrumentReturn(jump);
                     }
                 }));
+                exchangeLocked(returnHooksMutex_, jump2callback_, jump, callback);
             }
         }
     }
@@ -121,25 +225,22 @@ void Hooks::instrument(Function *function, const dflow::Dataflow *dataflow) {
 void Hooks::deinstrument(Function *function) {
     assert(function != nullptr);
 
-    if (auto callback = nc::find(function2callback_, function)) {
+    if (auto callback = takeLocked(entryHooksMutex_, function2callback_, function)) {
         deinstrumentEntry(function);
         callback->basicBlock()->erase(callback);
-        function2callback_.erase(function);
     }
 
     foreach (auto basicBlock, function->basicBlocks()) {
         foreach (auto statement, basicBlock->statements()) {
             if (auto call = statement->as<Call>()) {
-                if (auto callback = nc::find(call2callback_, call)) {
+                if (auto callback = takeLocked(callHooksMutex_, call2callback_, call)) {
                     deinstrumentCall(call);
                     callback->basicBlock()->erase(callback);
-                    call2callback_.erase(call);
                 }
             } else if (auto jump = statement->as<Jump>()) {
-                if (auto callback = nc::find(jump2callback_, jump)) {
+                if (auto callback = takeLocked(returnHooksMutex_, jump2callback_, jump)) {
                     deinstrumentReturn(jump);
                     callback->basicBlock()->erase(callback);
-                    jump2callback_.erase(jump);
                 }
             }
         }
@@ -149,32 +250,24 @@ void Hooks::deinstrument(Function *function) {
 void Hooks::instrumentEntry(Function *function) {
     auto convention = getConvention(getCalleeId(function));
     auto signature = signatures_.getSignature(function).get();
-    auto &entryHook = entryHooks_[std::make_tuple(function, convention, signature)];
-
-    if (!entryHook) {
-        entryHook = std::make_unique<EntryHook>(convention, signature);
-    }
 
-    auto &lastEntryHook = lastEntryHooks_[function];
+    auto entryHook = getHook(entryHooksMutex_, entryHooks_, std::make_tuple(function, convention, signature), [&]() {
+        return std::make_unique<EntryHook>(convention, signature);
+    });
+    auto lastEntryHook = exchangeLocked(entryHooksMutex_, lastEntryHooks_, function, entryHook);
 
-    if (entryHook.get() != lastEntryHook) {
+    if (entryHook != lastEntryHook) {
         if (lastEntryHook) {
             lastEntryHook->patch().remove();
         }
-        if (entryHook) {
-            auto callback = nc::find(function2callback_, function);
-            entryHook->patch().insertAfter(callback);
-        }
-        lastEntryHook = entryHook.get();
+        auto callback = findLocked(entryHooksMutex_, function2callback_, function);
+        entryHook->patch().insertAfter(callback);
     }
 }
 
 void Hooks::deinstrumentEntry(Function *function) {
-    auto &lastEntryHook = lastEntryHooks_[function];
-
-    if (lastEntryHook) {
+    if (auto lastEntryHook = exchangeLocked(entryHooksMutex_, lastEntryHooks_, function, nullptr)) {
         lastEntryHook->patch().remove();
-        lastEntryHook = nullptr;
     }
 }
 
@@ -182,33 +275,25 @@ void Hooks::instrumentCall(Call *call, const dflow::Dataflow &dataflow) {
     auto calleeId = getCalleeId(call, dataflow);
     auto convention = getConvention(calleeId);
     auto signature = signatures_.getSignature(call).get();
-    auto stackArgumentsSize = conventions_.getStackArgumentsSize(calleeId);
-    auto &callHook = callHooks_[std::make_tuple(call, convention, signature, stackArgumentsSize)];
+    auto stackArgumentsSize = getStackArgumentsSize(calleeId);
 
-    if (!callHook) {
-        callHook = std::make_unique<CallHook>(convention, signature, stackArgumentsSize);
-    }
+    auto callHook = getHook(callHooksMutex_, callHooks_, std::make_tuple(call, convention, signature, stackArgumentsSize), [&]() {
+        return std::make_unique<CallHook>(convention, signature, stackArgumentsSize);
+    });
+    auto lastCallHook = exchangeLocked(callHooksMutex_, lastCallHooks_, call, callHook);
 
-    auto &lastCallHook = lastCallHooks_[call];
-
-    if (callHook.get() != lastCallHook) {
+    if (callHook != lastCallHook) {
         if (lastCallHook) {
             lastCallHook->patch().remove();
         }
-        if (callHook) {
-            auto callback = nc::find(call2callback_, call);
-            callHook->patch().insertAfter(callback);
-        }
-        lastCallHook = callHook.get();
+        auto callback = findLocked(callHooksMutex_, call2callback_, call);
+        callHook->patch().insertAfter(callback);
     }
 }
 
 void Hooks::deinstrumentCall(Call *call) {
-    auto &lastCallHook = lastCallHooks_[call];
-
-    if (lastCallHook) {
+    if (auto lastCallHook = exchangeLocked(callHooksMutex_, lastCallHooks_, call, nullptr)) {
         lastCallHook->patch().remove();
-        lastCallHook = nullptr;
     }
 }
 
@@ -216,32 +301,24 @@ void Hooks::instrumentReturn(Jump *jump) {
     auto function = jump->basicBlock()->function();
     auto convention = getConvention(getCalleeId(function));
     auto signature = signatures_.getSignature(function).get();
-    auto &returnHook = returnHooks_[std::make_tuple(jump, convention, signature)];
 
-    if (!returnHook) {
-        returnHook = std::make_unique<ReturnHook>(convention, signature);
-    }
+    auto returnHook = getHook(returnHooksMutex_, returnHooks_, std::make_tuple(jump, convention, signature), [&]() {
+        return std::make_unique<ReturnHook>(convention, signature);
+    });
+    auto lastReturnHook = exchangeLocked(returnHooksMutex_, lastReturnHooks_, jump, returnHook);
 
-    auto &lastReturnHook = lastReturnHooks_[jump];
-
-    if (returnHook.get() != lastReturnHook) {
+    if (returnHook != lastReturnHook) {
         if (lastReturnHook) {
             lastReturnHook->patch().remove();
         }
-        if (returnHook) {
-            auto callback = nc::find(jump2callback_, jump);
-            returnHook->patch().insertAfter(callback);
-        }
-        lastReturnHook = returnHook.get();
+        auto callback = findLocked(returnHooksMutex_, jump2callback_, jump);
+        returnHook->patch().insertAfter(callback);
     }
 }
 
 void Hooks::deinstrumentReturn(Jump *jump) {
-    auto &lastReturnHook = lastReturnHooks_[jump];
-
-    if (lastReturnHook) {
+    if (auto lastReturnHook = exchangeLocked(returnHooksMutex_, lastReturnHooks_, jump, nullptr)) {
         lastReturnHook->patch().remove();
-        lastReturnHook = nullptr;
     }
 }
 
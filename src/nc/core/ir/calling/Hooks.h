@@ -32,6 +32,7 @@
  */
 #include <functional>
 #include <map> 
+#include <mutex>
 #include <tuple>
 #include <vector>
 
@@ -71,6 +72,11 @@ class Signatures;
  * Hooks manager: it is responsible for instrumenting functions
  * with special hooks that take care of handling calling-convention-specific
  * stuff.
+ *
+ * Different functions can be instrumented and analyzed concurrently.
+ * The mappings shared by all functions are locked only while being
+ * looked up or updated. The callbacks inspect the dataflow information
+ * and patch the function without holding any locks.
  */
 class Hooks {
     /** Assigned calling conventions. */
@@ -79,6 +85,18 @@ class Hooks {
     /** Signatures of functions. */
     const Signatures &signatures_;
 
+    /** Mutex guarding the accesses to the assigned calling conventions and their detection. */
+    mutable std::mutex conventionsMutex_;
+
+    /** Mutex guarding function2callback_, entryHooks_, and lastEntryHooks_. */
+    mutable std::mutex entryHooksMutex_;
+
+    /** Mutex guarding call2callback_, callHooks_, and lastCallHooks_. */
+    mutable std::mutex callHooksMutex_;
+
+    /** Mutex guarding jump2callback_, returnHooks_, and lastReturnHooks_. */
+    mutable std::mutex returnHooksMutex_;
+
 public:
     /** Type for the calling convention detector callback. */
     typedef std::function<void(const CalleeId &)> ConventionDetector;
@@ -196,6 +214,13 @@ public:
     void deinstrument(Function *function);
 
 private:
+    /**
+     * \param calleeId Callee id.
+     *
+     * \return Size of the arguments passed on the stack, or boost::none if unknown.
+     */
+    boost::optional<ByteSize> getStackArgumentsSize(const CalleeId &calleeId) const;
+
     /**
      * Creates an EntryHook (if not done yet) and instruments the function with it.
      * If the function was previously instrumented, deinstruments it.
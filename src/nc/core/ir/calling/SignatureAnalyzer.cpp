@@ -4,12 +4,16 @@
 #include "SignatureAnalyzer.h"
 
 #include <cstdint> /* uintptr_t */
+#include <functional>
+#include <queue>
 
 #include <boost/range/adaptor/map.hpp>
+#include <boost/unordered_set.hpp>
 
 #include <nc/common/Foreach.h>
 #include <nc/common/make_unique.h>
 
+#include <nc/core/ir/AnalysisCache.h>
 #include <nc/core/ir/BasicBlock.h>
 #include <nc/core/ir/Function.h>
 #include <nc/core/ir/Functions.h>
@@ -36,10 +40,10 @@ namespace ir {
 namespace calling {
 
 SignatureAnalyzer::SignatureAnalyzer(Signatures &signatures, const dflow::Dataflows &dataflows, const Hooks &hooks,
-                                     const liveness::Livenesses &livenesses, const CancellationToken &canceled,
-                                     const LogToken &log)
-    : signatures_(signatures), dataflows_(dataflows), hooks_(hooks), livenesses_(livenesses), canceled_(canceled),
-      log_(log) {
+                                     const liveness::Livenesses &livenesses, AnalysisCache &analysisCache,
+                                     const CancellationToken &canceled, const LogToken &log)
+    : signatures_(signatures), dataflows_(dataflows), hooks_(hooks), livenesses_(livenesses),
+      analysisCache_(analysisCache), canceled_(canceled), log_(log) {
 }
 
 SignatureAnalyzer::~SignatureAnalyzer() {}
@@ -56,7 +60,13 @@ void SignatureAnalyzer::computeMappings() {
         auto function = functionAndDataflow.first;
         auto &dataflow = *functionAndDataflow.second;
 
-        id2referrers_[getCalleeId(function)].functions.push_back(function);
+        auto functionId = getCalleeId(function);
+        id2referrers_[functionId].functions.push_back(function);
+
+        auto &calleeIds = function2calleeIds_[function];
+        calleeIds.push_back(functionId);
+        boost::unordered_set<CalleeId> seenCalleeIds;
+        seenCalleeIds.insert(functionId);
 
         foreach (auto basicBlock, function->basicBlocks()) {
             foreach (auto statement, basicBlock->statements()) {
@@ -66,6 +76,10 @@ void SignatureAnalyzer::computeMappings() {
                     id2referrers_[id].calls.push_back(call);
                     function2calls_[function].push_back(call);
 
+                    if (seenCalleeIds.insert(id).second) {
+                        calleeIds.push_back(id);
+                    }
+
                     foreach (const auto &locationAndTerm, hooks_.getCallHook(call)->speculativeReturnValueTerms()) {
                         speculativeReturnValueTerm2calleeId_[locationAndTerm.second] = id;
                     }
@@ -88,33 +102,167 @@ void SignatureAnalyzer::computeMappings() {
 
 void SignatureAnalyzer::computeUses() {
     foreach (const auto &functionAndDataflow, dataflows_) {
-        function2uses_[functionAndDataflow.first] = std::make_unique<dflow::Uses>(*functionAndDataflow.second);
+        function2uses_[functionAndDataflow.first] =
+            &analysisCache_.getUses(functionAndDataflow.first, *functionAndDataflow.second);
     }
 }
 
 void SignatureAnalyzer::computeArgumentsAndReturnValues() {
-    int niterations = 0;
+    /* Number callee ids. */
+    std::vector<CalleeId> ids;
+    boost::unordered_map<CalleeId, std::size_t> id2index;
+
+    ids.reserve(id2referrers_.size());
+    foreach (const CalleeId &calleeId, id2referrers_ | boost::adaptors::map_keys) {
+        id2index[calleeId] = ids.size();
+        ids.push_back(calleeId);
+    }
+
+    /*
+     * Build the call graph on callee ids and, for each callee id, the list of
+     * functions whose analysis results depend on its arguments and return value.
+     * Recomputing a callee id reads the undefined uses of its functions and the
+     * unused defines and used return values of the calls to it. All of these
+     * are computed over the whole function containing them, which in turn
+     * depends on all the callee ids listed in function2calleeIds_.
+     */
+    std::vector<std::vector<std::size_t>> callees(ids.size());
+    std::vector<std::vector<const Function *>> dependentFunctions(ids.size());
+    boost::unordered_map<const Function *, std::vector<std::size_t>> function2indices;
+
+    foreach (const auto &functionAndIds, function2calleeIds_) {
+        auto &indices = function2indices[functionAndIds.first];
+        indices.reserve(functionAndIds.second.size());
+
+        foreach (const auto &calleeId, functionAndIds.second) {
+            auto index = nc::find(id2index, calleeId);
+            indices.push_back(index);
+            dependentFunctions[index].push_back(functionAndIds.first);
+        }
+
+        auto &successors = callees[indices.front()];
+        successors.insert(successors.end(), indices.begin() + 1, indices.end());
+    }
+
+    /*
+     * Find strongly connected components using an iterative version of
+     * Tarjan's algorithm. It emits a component only after all the components
+     * reachable from it, i.e. callees come before their callers. Each callee
+     * id gets a rank: its position in this bottom-up order.
+     */
+    const std::size_t unvisited = static_cast<std::size_t>(-1);
+
+    std::vector<std::size_t> rank(ids.size(), unvisited);
+    std::vector<std::size_t> preorder(ids.size(), unvisited);
+    std::vector<std::size_t> lowlink(ids.size());
+    std::vector<bool> onStack(ids.size(), false);
+    std::vector<std::size_t> stack;
+    std::vector<std::pair<std::size_t, std::size_t>> path; // Pairs of a node and the index of its next successor.
+    std::size_t npreordered = 0;
+    std::size_t nranked = 0;
+
+    for (std::size_t root = 0; root < ids.size(); ++root) {
+        if (preorder[root] != unvisited) {
+            continue;
+        }
 
-    bool changed;
-    do {
-        changed = false;
+        auto enter = [&](std::size_t node) {
+            preorder[node] = lowlink[node] = npreordered++;
+            stack.push_back(node);
+            onStack[node] = true;
+            path.push_back(std::make_pair(node, 0));
+        };
+
+        enter(root);
+
+        while (!path.empty()) {
+            auto node = path.back().first;
+            auto &nextSuccessor = path.back().second;
+
+            if (nextSuccessor < callees[node].size()) {
+                auto successor = callees[node][nextSuccessor++];
+                if (preorder[successor] == unvisited) {
+                    enter(successor);
+                } else if (onStack[successor]) {
+                    lowlink[node] = std::min(lowlink[node], preorder[successor]);
+                }
+                continue;
+            }
 
-        foreach (const CalleeId &calleeId, id2referrers_ | boost::adaptors::map_keys) {
-            if (computeArguments(calleeId)) {
-                changed = true;
+            path.pop_back();
+            if (!path.empty()) {
+                auto parent = path.back().first;
+                lowlink[parent] = std::min(lowlink[parent], lowlink[node]);
             }
-            if (computeReturnValue(calleeId)) {
-                changed = true;
+
+            if (lowlink[node] == preorder[node]) {
+                std::size_t member;
+                do {
+                    member = stack.back();
+                    stack.pop_back();
+                    onStack[member] = false;
+                    rank[member] = nranked++;
+                } while (member != node);
             }
         }
+    }
 
-        if (++niterations > 3) {
-            log_.warning(tr("Fixpoint was not reached after %1 iterations while reconstructing arguments. Giving up.").arg(niterations));
+    /*
+     * Process callee ids in the order of their ranks, always taking the
+     * lowest-ranked pending one. Thus, a component is recomputed until it
+     * stabilizes before its callers are looked at, and a change in a caller
+     * that affects callees sends the analysis back down only to those callees.
+     */
+    std::vector<std::size_t> rank2index(ids.size());
+    for (std::size_t index = 0; index < ids.size(); ++index) {
+        rank2index[rank[index]] = index;
+    }
+
+    std::priority_queue<std::size_t, std::vector<std::size_t>, std::greater<std::size_t>> queue;
+    std::vector<bool> queued(ids.size(), true);
+    for (std::size_t r = 0; r < ids.size(); ++r) {
+        queue.push(r);
+    }
+
+    /*
+     * Normally, the analysis converges quickly. The limit only guards
+     * against the (theoretically possible) oscillation of results.
+     */
+    const std::size_t maxRecomputationsPerId = 16;
+    std::size_t budget = ids.size() * maxRecomputationsPerId;
+    std::size_t nrecomputations = 0;
+
+    while (!queue.empty()) {
+        auto index = rank2index[queue.top()];
+        queue.pop();
+        queued[index] = false;
+
+        if (nrecomputations++ == budget) {
+            log_.warning(tr("Fixpoint was not reached after %1 recomputations of %2 callee ids while reconstructing arguments. Giving up.")
+                .arg(nrecomputations).arg(ids.size()));
             break;
         }
 
+        const auto &calleeId = ids[index];
+
+        bool changed = computeArguments(calleeId);
+        if (computeReturnValue(calleeId)) {
+            changed = true;
+        }
+
+        if (changed) {
+            foreach (auto function, dependentFunctions[index]) {
+                foreach (auto dependentIndex, nc::find(function2indices, function)) {
+                    if (!queued[dependentIndex]) {
+                        queued[dependentIndex] = true;
+                        queue.push(rank[dependentIndex]);
+                    }
+                }
+            }
+        }
+
         canceled_.poll();
-    } while (changed);
+    }
 }
 
 namespace {
@@ -343,14 +491,11 @@ std::vector<MemoryLocation> SignatureAnalyzer::getUndefinedUses(const Function *
      * can be passed, and nobody defines this memory location, this
      * location is likely to be actually used for passing an argument.
      */
-    foreach (const auto &termAndLocation, dataflow.term2location()) {
-        auto term = termAndLocation.first;
-        const auto &memoryLocation = termAndLocation.second;
-
+    dataflow.term2location().forEach([&](const Term *term, const MemoryLocation &memoryLocation) {
         if (memoryLocation && term->isRead() && dataflow.getDefinitions(term).empty() && intersect(term, memoryLocation)) {
             result.push_back(memoryLocation);
         }
-    }
+    });
 
     /*
      * If a call has an argument whose memory location can be used
@@ -23,6 +23,7 @@ namespace nc {
 namespace core {
 namespace ir {
 
+class AnalysisCache;
 class Call;
 class Functions;
 class Jump;
@@ -54,6 +55,7 @@ class SignatureAnalyzer {
     const dflow::Dataflows &dataflows_;
     const Hooks &hooks_;
     const liveness::Livenesses &livenesses_;
+    AnalysisCache &analysisCache_;
     const CancellationToken &canceled_;
     const LogToken &log_;
 
@@ -72,11 +74,18 @@ class SignatureAnalyzer {
     /** Mapping from a function to the list of returns in it.*/
     boost::unordered_map<const Function *, std::vector<const Jump *>> function2returns_;
 
+    /**
+     * Mapping from a function to the callee ids whose arguments and return values
+     * are used when analyzing this function: the id of the function itself
+     * followed by the distinct ids of the calls in it.
+     */
+    boost::unordered_map<const Function *, std::vector<CalleeId>> function2calleeIds_;
+
     /** Mapping of terms that represent potential return values in the hooks to callee ids. */
     boost::unordered_map<const Term *, CalleeId> speculativeReturnValueTerm2calleeId_;
 
     /** Mapping from a function to the term use information for this function. */
-    boost::unordered_map<const Function *, std::unique_ptr<dflow::Uses>> function2uses_;
+    boost::unordered_map<const Function *, const dflow::Uses *> function2uses_;
 
     /** Mapping from a callee id to the list of its formal arguments. */
     boost::unordered_map<CalleeId, std::vector<MemoryLocation>> id2arguments_;
@@ -96,11 +105,13 @@ public:
      * \param dataflows Dataflows.
      * \param hooks Hooks manager.
      * \param livenesses Livenesses.
+     * \param analysisCache Cache of per-function analyses.
      * \param canceled Cancellation token.
      * \param log Log token.
      */
     SignatureAnalyzer(Signatures &signatures, const dflow::Dataflows &dataflows, const Hooks &hooks,
-                      const liveness::Livenesses &livenesses, const CancellationToken &canceled, const LogToken &log);
+                      const liveness::Livenesses &livenesses, AnalysisCache &analysisCache,
+                      const CancellationToken &canceled, const LogToken &log);
 
     /**
      * Destructor.
@@ -121,7 +132,12 @@ private:
     void computeUses();
 
     /**
-     * Computes locations of arguments for all functions.
+     * Computes locations of arguments and return values for all functions.
+     *
+     * Callee ids are processed bottom-up over the strongly connected
+     * components of the call graph. When the arguments or the return value
+     * of a callee id change, only the callee ids whose inputs depend on it
+     * are recomputed.
      */
     void computeArgumentsAndReturnValues();
 
@@ -24,6 +24,8 @@
 
 #include "Dfs.h"
 
+#include <algorithm>
+
 #include <nc/common/Foreach.h>
 #include <nc/common/Range.h>
 #include <nc/common/Unreachable.h>
@@ -36,7 +38,9 @@ namespace core {
 namespace ir {
 namespace cflow {
 
-Dfs::Dfs(const cflow::Region *region) {
+Dfs::Dfs(const cflow::Region *region):
+    orderingsValid_(true)
+{
     assert(region != nullptr);
 
     preordering_.reserve(region->nodes().size());
@@ -45,7 +49,7 @@ Dfs::Dfs(const cflow::Region *region) {
     visit(region->entry());
 
     foreach (cflow::Node *node, region->nodes()) {
-        if (find(node2color_, node) == WHITE) {
+        if (node2info_[node].color == WHITE) {
             visit(node);
         }
     }
@@ -53,15 +57,20 @@ Dfs::Dfs(const cflow::Region *region) {
 
 void Dfs::visit(cflow::Node *node) {
     assert(node != nullptr);
-    assert(find(node2color_, node) == WHITE);
 
-    node2color_[node] = GRAY;
+    auto &info = node2info_[node];
+    assert(info.color == WHITE);
+
+    info.color = GRAY;
+    info.preorderNumber = preordering_.size();
     preordering_.push_back(node);
 
     foreach (cflow::Edge *edge, node->outEdges()) {
-        switch (find(node2color_, edge->head())) {
+        auto &headInfo = node2info_[edge->head()];
+        switch (headInfo.color) {
         case WHITE:
             edge2type_[edge] = FORWARD;
+            headInfo.parent = node;
             visit(edge->head());
             break;
         case GRAY:
@@ -75,10 +84,138 @@ void Dfs::visit(cflow::Node *node) {
         }
     }
 
-    node2color_[node] = BLACK;
+    info.color = BLACK;
+    info.postorderNumber = postordering_.size();
     postordering_.push_back(node);
 }
 
+std::size_t Dfs::getPostorderNumber(const Node *node) const {
+    assert(node != nullptr);
+    assert(nc::contains(node2info_, node));
+
+    return node2info_.find(node)->second.postorderNumber;
+}
+
+bool Dfs::collapse(const Node *entry, const std::vector<Node *> &nodes, Node *subregion) {
+    assert(entry != nullptr);
+    assert(subregion != nullptr);
+
+    /*
+     * A new search visits the nodes outside the subregion in the same order
+     * as the old one did if the subregion is discovered at the same moment
+     * as its entry was, and the successors of the subregion are discovered
+     * from the subregion in the same order as they were from its nodes.
+     * The region's entry is the first node visited, other roots of the
+     * DFS forest are tried in the order of region's nodes, which changes
+     * when the subregion is added, therefore the entry must have been
+     * discovered either first or via a tree edge.
+     */
+    auto entryIter = node2info_.find(entry);
+    if (entryIter == node2info_.end()) {
+        return false;
+    }
+    const NodeInfo entryInfo = entryIter->second;
+    if (entryInfo.parent == nullptr && entryInfo.preorderNumber != 0) {
+        return false;
+    }
+
+    /* All the nodes of the subregion must have been discovered during the visit of the entry. */
+    boost::unordered_set<const Node *> nodeSet;
+    foreach (auto node, nodes) {
+        auto i = node2info_.find(node);
+        if (i == node2info_.end() ||
+            i->second.preorderNumber < entryInfo.preorderNumber ||
+            i->second.postorderNumber > entryInfo.postorderNumber) {
+            return false;
+        }
+        nodeSet.insert(node);
+    }
+
+    /*
+     * Successors of the subregion discovered during the visit of the entry
+     * must be either children of subregion's nodes in the DFS tree, in the
+     * order of the subregion's out edges, or descendants of such children
+     * that were already visited.
+     */
+    std::vector<Node *> children;
+    std::vector<EdgeType> edgeTypes;
+    edgeTypes.reserve(subregion->outEdges().size());
+
+    foreach (const Edge *edge, subregion->outEdges()) {
+        auto i = node2info_.find(edge->head());
+        if (i == node2info_.end() || nc::contains(nodeSet, edge->head())) {
+            return false;
+        }
+        const auto &headInfo = i->second;
+
+        if (headInfo.preorderNumber > entryInfo.preorderNumber) {
+            if (std::any_of(children.begin(), children.end(), [&](const Node *child) -> bool {
+                const auto &childInfo = node2info_.find(child)->second;
+                return childInfo.preorderNumber <= headInfo.preorderNumber &&
+                       headInfo.postorderNumber <= childInfo.postorderNumber;
+            })) {
+                edgeTypes.push_back(CROSS);
+            } else if (nc::contains(nodeSet, headInfo.parent) &&
+                       (children.empty() ||
+                        node2info_.find(children.back())->second.preorderNumber < headInfo.preorderNumber)) {
+                children.push_back(edge->head());
+                edgeTypes.push_back(FORWARD);
+            } else {
+                return false;
+            }
+        } else if (headInfo.postorderNumber > entryInfo.postorderNumber) {
+            edgeTypes.push_back(BACK);
+        } else {
+            edgeTypes.push_back(CROSS);
+        }
+    }
+
+    /* The subregion takes the place of its entry. */
+    foreach (auto node, nodes) {
+        node2info_.erase(node);
+        foreach (const Edge *edge, node->outEdges()) {
+            edge2type_.erase(edge);
+        }
+    }
+    node2info_[subregion] = entryInfo;
+
+    foreach (auto child, children) {
+        node2info_[child].parent = subregion;
+    }
+
+    std::size_t index = 0;
+    foreach (const Edge *edge, subregion->outEdges()) {
+        edge2type_[edge] = edgeTypes[index++];
+    }
+
+    orderingsValid_ = false;
+
+    return true;
+}
+
+void Dfs::updateOrderings() const {
+    if (orderingsValid_) {
+        return;
+    }
+
+    preordering_.clear();
+    postordering_.clear();
+
+    foreach (const auto &nodeAndInfo, node2info_) {
+        preordering_.push_back(const_cast<Node *>(nodeAndInfo.first));
+    }
+    postordering_ = preordering_;
+
+    std::sort(preordering_.begin(), preordering_.end(), [this](const Node *a, const Node *b) -> bool {
+        return node2info_.find(a)->second.preorderNumber < node2info_.find(b)->second.preorderNumber;
+    });
+    std::sort(postordering_.begin(), postordering_.end(), [this](const Node *a, const Node *b) -> bool {
+        return node2info_.find(a)->second.postorderNumber < node2info_.find(b)->second.postorderNumber;
+    });
+
+    orderingsValid_ = true;
+}
+
 } // namespace cflow
 } // namespace ir
 } // namespace core
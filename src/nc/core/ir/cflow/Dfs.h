@@ -25,6 +25,7 @@
 
 #include <nc/config.h>
 
+#include <cstddef>
 #include <vector>
 
 #include <boost/unordered_map.hpp>
@@ -44,6 +45,9 @@ class Region;
 /**
  * This class performs a depth-first search in a given region, sorts its
  * nodes topologically, detects back edges.
+ *
+ * When a set of nodes is collapsed into a subregion, the results of the
+ * search can often be updated locally, without searching the whole region again.
  */
 class Dfs {
 public:
@@ -63,14 +67,27 @@ public:
     };
 
 private:
-    /** List of region nodes in the order of discovery. */
-    std::vector<Node *> preordering_;
+    /** Information about a node. */
+    struct NodeInfo {
+        NodeColor color; ///< Color of the node.
+        std::size_t preorderNumber; ///< Number of the node in the order of discovery.
+        std::size_t postorderNumber; ///< Number of the node in the order of leaving.
+        Node *parent; ///< Node from which the node was discovered, nullptr for roots of the DFS forest.
+
+        NodeInfo(): color(WHITE), preorderNumber(0), postorderNumber(0), parent(nullptr) {}
+    };
+
+    /** List of region nodes in the order of discovery. Valid if orderingsValid_ is true. */
+    mutable std::vector<Node *> preordering_;
+
+    /** List of region nodes in the order of leaving. Valid if orderingsValid_ is true. */
+    mutable std::vector<Node *> postordering_;
 
-    /** List of region nodes in the order of leaving. */
-    std::vector<Node *> postordering_;
+    /** Whether preordering_ and postordering_ are up to date. */
+    mutable bool orderingsValid_;
 
-    /** Mapping from a node to its color. */
-    boost::unordered_map<const Node *, NodeColor> node2color_;
+    /** Mapping from a node to the information about it. */
+    boost::unordered_map<const Node *, NodeInfo> node2info_;
 
     /** Mapping from an edge to its type. */
     boost::unordered_map<const Edge *, EdgeType> edge2type_;
@@ -87,22 +104,30 @@ public:
     /**
      * \return List of region nodes in the order of discovery.
      */
-    std::vector<Node *> &preordering() { return preordering_; }
+    std::vector<Node *> &preordering() { updateOrderings(); return preordering_; }
 
     /**
      * \return List of region nodes in the order of discovery.
      */
-    const std::vector<Node *> &preordering() const { return preordering_; }
+    const std::vector<Node *> &preordering() const { updateOrderings(); return preordering_; }
 
     /**
      * \return List of region nodes in the order of leaving.
      */
-    std::vector<Node *> &postordering() { return postordering_; }
+    std::vector<Node *> &postordering() { updateOrderings(); return postordering_; }
 
     /**
      * \return List of region nodes in the order of leaving.
      */
-    const std::vector<Node *> &postordering() const { return postordering_; }
+    const std::vector<Node *> &postordering() const { updateOrderings(); return postordering_; }
+
+    /**
+     * \param node Valid pointer to a node of the region.
+     *
+     * \return Key ordering the node relative to the other nodes in the order of leaving.
+     *         Keys of different nodes are different, but not necessarily consecutive.
+     */
+    std::size_t getPostorderNumber(const Node *node) const;
 
     /**
      * \param edge Valid pointer to an edge.
@@ -111,6 +136,20 @@ public:
      */
     EdgeType getEdgeType(const Edge *edge) const { return nc::find(edge2type_, edge, UNKNOWN); }
 
+    /**
+     * Updates the results of the search after given nodes of the region
+     * have been replaced by a subregion. The update succeeds only if its
+     * results are exactly the same as the ones of a new search in the region.
+     *
+     * \param entry       Valid pointer to the node through which the subregion is entered.
+     * \param nodes       Nodes that have been moved into the subregion, including the entry.
+     * \param subregion   Valid pointer to the subregion.
+     *
+     * \return True if the results have been updated, false if a new search is necessary.
+     *         In the latter case, the results are left unchanged.
+     */
+    bool collapse(const Node *entry, const std::vector<Node *> &nodes, Node *subregion);
+
 private:
 
     /**
@@ -119,6 +158,11 @@ private:
      * \param node Valid pointer to a not yet visited node.
      */
     void visit(Node *node);
+
+    /**
+     * Makes preordering_ and postordering_ consistent with the node information.
+     */
+    void updateOrderings() const;
 };
 
 } // namespace cflow
@@ -25,12 +25,14 @@
 #include "StructureAnalyzer.h"
 
 #include <algorithm>
+#include <map>
 #include <queue>
 
 #include <boost/unordered_map.hpp>
 
 #include <nc/common/Foreach.h>
 #include <nc/common/Range.h>
+#include <nc/common/Unreachable.h>
 #include <nc/common/make_unique.h>
 
 #include <nc/core/ir/BasicBlock.h>
@@ -56,70 +58,127 @@ void StructureAnalyzer::analyze() {
     analyze(graph_.root());
 }
 
-void StructureAnalyzer::analyze(Region *region) {
-    bool changed;
+namespace {
 
-    do {
-        changed = false;
+/**
+ * Kinds of reductions, in the order of their priority.
+ */
+enum ReductionKind {
+    COMPOUND_CONDITION,
+    CYCLIC,
+    BLOCK,
+    CONDITIONAL,
+    SWITCH_OR_HOPELESS_CONDITIONAL,
+    REDUCTION_KIND_COUNT
+};
 
-        /*
-         * Classify edges, sort nodes topologically.
-         */
-        Dfs dfs(region);
+} // anonymous namespace
 
-        /*
-         * Try to reduce various kinds of regions.
-         */
-        foreach (Node *node, dfs.postordering()) {
-            if (reduceCompoundCondition(node)) {
-                changed = true;
-                break;
-            }
-        }
-        if (changed) {
-            continue;
+void StructureAnalyzer::analyze(Region *region) {
+    /*
+     * Classify edges, sort nodes topologically.
+     */
+    Dfs dfs(region);
+
+    /*
+     * For each kind of reduction, the nodes at which it must be tried,
+     * ordered by their postorder numbers.
+     *
+     * A reduction failing before an attempt to insert a subregion depends
+     * only on the node, its neighbours, and the types of the node's in edges.
+     * Such a node is not tried again until its neighbourhood changes.
+     */
+    std::map<std::size_t, Node *> candidates[REDUCTION_KIND_COUNT];
+
+    auto addCandidate = [&](Node *node) {
+        auto postorderNumber = dfs.getPostorderNumber(node);
+        for (int kind = 0; kind < REDUCTION_KIND_COUNT; ++kind) {
+            candidates[kind][postorderNumber] = node;
         }
+    };
 
+    auto resetCandidates = [&]() {
+        for (int kind = 0; kind < REDUCTION_KIND_COUNT; ++kind) {
+            candidates[kind].clear();
+        }
         foreach (Node *node, dfs.postordering()) {
-            if (reduceCyclic(node, dfs)) {
-                changed = true;
-                break;
-            }
+            addCandidate(node);
         }
-        if (changed) {
-            continue;
+    };
+
+    auto reduce = [&](int kind, Node *node) -> bool {
+        switch (kind) {
+        case COMPOUND_CONDITION:
+            return reduceCompoundCondition(node);
+        case CYCLIC:
+            return reduceCyclic(node, dfs);
+        case BLOCK:
+            return reduceBlock(node);
+        case CONDITIONAL:
+            return reduceConditional(node);
+        case SWITCH_OR_HOPELESS_CONDITIONAL:
+            return reduceSwitch(node) || reduceHopelessConditional(node);
+        default:
+            unreachable();
         }
+    };
 
-        foreach (Node *node, dfs.postordering()) {
-            if (reduceBlock(node)) {
-                changed = true;
-                break;
+    resetCandidates();
+
+    while (true) {
+        /*
+         * Try to reduce various kinds of regions.
+         */
+        bool changed = false;
+
+        for (int kind = 0; kind < REDUCTION_KIND_COUNT && !changed; ++kind) {
+            for (auto i = candidates[kind].begin(); i != candidates[kind].end();) {
+                auto insertionAttempts = insertionAttempts_;
+
+                if (reduce(kind, i->second)) {
+                    changed = true;
+                    break;
+                }
+
+                if (insertionAttempts_ == insertionAttempts) {
+                    i = candidates[kind].erase(i);
+                } else {
+                    ++i;
+                }
             }
         }
-        if (changed) {
-            continue;
+
+        if (!changed) {
+            break;
         }
 
-        foreach (Node *node, dfs.postordering()) {
-            if (reduceConditional(node)) {
-                changed = true;
-                break;
+        /*
+         * Update the DFS results and the candidates.
+         */
+        foreach (Node *node, lastInsertion_.nodes) {
+            auto postorderNumber = dfs.getPostorderNumber(node);
+            for (int kind = 0; kind < REDUCTION_KIND_COUNT; ++kind) {
+                candidates[kind].erase(postorderNumber);
             }
         }
-        if (changed) {
-            continue;
-        }
 
-        foreach (Node *node, dfs.postordering()) {
-            if (reduceSwitch(node) || reduceHopelessConditional(node)) {
-                changed = true;
-                break;
+        if (!lastInsertion_.incomingEdgesDeleted &&
+            dfs.collapse(lastInsertion_.entry, lastInsertion_.nodes, lastInsertion_.subregion))
+        {
+            foreach (Node *node, lastInsertion_.touchedNodes) {
+                addCandidate(node);
+                foreach (const Edge *edge, node->inEdges()) {
+                    addCandidate(edge->tail());
+                }
+                foreach (const Edge *edge, node->outEdges()) {
+                    addCandidate(edge->head());
+                }
             }
+        } else {
+            dfs = Dfs(region);
+            resetCandidates();
         }
-        if (changed) {
-            continue;
-        }
-    } while (changed);
+    }
 }
 
 bool StructureAnalyzer::reduceBlock(Node *entry) {
@@ -329,7 +388,9 @@ bool StructureAnalyzer::reduceCyclic(Node *entry, const Dfs &dfs) {
     /*
      * Run structural analysis inside the loop region.
      */
+    auto insertion = std::move(lastInsertion_);
     analyze(loop);
+    lastInsertion_ = std::move(insertion);
 
     /*
      * Try to find a condition node.
@@ -569,6 +630,8 @@ Region *StructureAnalyzer::insertSubregion(Region *region, std::unique_ptr<Regio
     assert(region != nullptr);
     assert(subregion != nullptr);
 
+    ++insertionAttempts_;
+
     if (region->entry() == subregion->entry()) {
         region->setEntry(subregion.get());
     } else if (nc::contains(subregion->nodes(), region->entry())) {
@@ -627,6 +690,25 @@ Region *StructureAnalyzer::insertSubregion(Region *region, std::unique_ptr<Regio
         }
     }
 
+    Insertion insertion;
+    insertion.entry = subregion->entry();
+    insertion.nodes = subregion->nodes();
+    insertion.subregion = subregion.get();
+    insertion.touchedNodes = std::move(tails);
+    insertion.touchedNodes.insert(insertion.touchedNodes.end(), heads.begin(), heads.end());
+    insertion.touchedNodes.push_back(subregion.get());
+
+    foreach (Edge *edge, duplicateEdges) {
+        if (edge->tail()->parent() == region) {
+            insertion.touchedNodes.push_back(edge->tail());
+            insertion.incomingEdgesDeleted = true;
+        } else {
+            insertion.touchedNodes.push_back(edge->head());
+        }
+    }
+
+    lastInsertion_ = std::move(insertion);
+
     foreach (Edge *edge, edgesToSubregion) {
         edge->setHead(subregion.get());
     }
@@ -25,7 +25,9 @@
 
 #include <nc/config.h>
 
+#include <cstddef>
 #include <memory>
+#include <vector>
 
 namespace nc {
 namespace core {
@@ -52,6 +54,34 @@ class StructureAnalyzer {
     /** Dataflow information. */
     const dflow::Dataflow &dataflow_;
 
+    /**
+     * Information about the last successful insertion of a subregion.
+     */
+    struct Insertion {
+        /** Entry of the inserted subregion. */
+        const Node *entry;
+
+        /** Nodes moved into the subregion. */
+        std::vector<Node *> nodes;
+
+        /** Inserted subregion. */
+        Region *subregion;
+
+        /** Nodes of the region, including the subregion, whose edges have changed. */
+        std::vector<Node *> touchedNodes;
+
+        /** True if an edge from outside the subregion was deleted. */
+        bool incomingEdgesDeleted;
+
+        Insertion(): entry(nullptr), subregion(nullptr), incomingEdgesDeleted(false) {}
+    };
+
+    /** Information about the last successful insertion of a subregion. */
+    Insertion lastInsertion_;
+
+    /** Number of attempts to insert a subregion made so far. */
+    std::size_t insertionAttempts_;
+
 public:
     /**
      * Class constructor.
@@ -60,7 +90,7 @@ public:
      * \param dataflow Dataflow information.
      */
     StructureAnalyzer(Graph &graph, const dflow::Dataflow &dataflow):
-        graph_(graph), dataflow_(dataflow)
+        graph_(graph), dataflow_(dataflow), insertionAttempts_(0)
     {}
 
     /**
@@ -72,6 +102,10 @@ private:
     /**
      * Runs structural analysis in the region.
      *
+     * Reductions are tried in the order of their priority, and reductions
+     * of the same kind are tried in the postorder of the region's nodes.
+     * After each successful reduction, the search starts anew.
+     *
      * \param[in] region Valid pointer to a region.
      */
     void analyze(Region *region);
@@ -143,6 +177,7 @@ private:
      * All edges from the nodes of the subregion become edges from the subregion.
      * All edges to the entry node of the subregion become edges to the subregion.
      * All other edges as well as duplicate edges are deleted.
+     * On success, lastInsertion_ describes the insertion.
      *
      * \param region Valid pointer to the region.
      * \param subregion Valid pointer to the subregion.
@@ -56,6 +56,7 @@ namespace likec {
 
 namespace ir {
 
+class AnalysisCache;
 class Function;
 class Functions;
 class Term;
@@ -105,6 +106,7 @@ class CodeGenerator: boost::noncopyable {
     const cflow::Graphs &graphs_;
     const liveness::Livenesses &livenesses_;
     const types::Types &types_;
+    AnalysisCache &analysisCache_;
     const CancellationToken &cancellationToken_;
     const NameGenerator nameGenerator_;
 
@@ -135,16 +137,17 @@ public:
      * \param[in] graphs Reduced control-flow graphs.
      * \param[in] livenesses Liveness information for all functions.
      * \param[in] types Information about types.
+     * \param analysisCache Cache of per-function analyses.
      * \param[in] cancellationToken Cancellation token.
      */
     CodeGenerator(likec::Tree &tree, const image::Image &image, const Functions &functions, const calling::Hooks &hooks,
         const calling::Signatures &signatures, const dflow::Dataflows &dataflows, const vars::Variables &variables,
         const cflow::Graphs &graphs, const liveness::Livenesses &livenesses, const types::Types &types,
-        const CancellationToken &cancellationToken
+        AnalysisCache &analysisCache, const CancellationToken &cancellationToken
     ):
         tree_(tree), image_(image), functions_(functions), hooks_(hooks), signatures_(signatures),
         dataflows_(dataflows), variables_(variables), graphs_(graphs), livenesses_(livenesses),
-        types_(types), cancellationToken_(cancellationToken), nameGenerator_(image)
+        types_(types), analysisCache_(analysisCache), cancellationToken_(cancellationToken), nameGenerator_(image)
     {}
 
     /**
@@ -197,6 +200,11 @@ public:
      */
     const types::Types &types() const { return types_; }
 
+    /**
+     * \return Cache of per-function analyses.
+     */
+    AnalysisCache &analysisCache() const { return analysisCache_; }
+
     /**
      * \return Cancellation token.
      */
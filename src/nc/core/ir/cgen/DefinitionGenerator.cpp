@@ -36,6 +36,7 @@
 #include <nc/core/image/Reader.h>
 #include <nc/core/image/Section.h>
 #endif
+#include <nc/core/ir/AnalysisCache.h>
 #include <nc/core/ir/BasicBlock.h>
 #include <nc/core/ir/CFG.h>
 #include <nc/core/ir/Dominators.h>
@@ -102,9 +103,9 @@ DefinitionGenerator::DefinitionGenerator(CodeGenerator &parent, const Function *
     dataflow_(*parent.dataflows().at(function)),
     graph_(*parent.graphs().at(function)),
     liveness_(*parent.livenesses().at(function)),
-    uses_(std::make_unique<dflow::Uses>(dataflow_)),
-    cfg_(std::make_unique<CFG>(function->basicBlocks())),
-    dominators_(std::make_unique<Dominators>(*cfg_, canceled)),
+    uses_(parent.analysisCache().getUses(function, dataflow_)),
+    cfg_(parent.analysisCache().getCFG(function)),
+    dominators_(parent.analysisCache().getDominators(function, canceled)),
     hookStatements_(getHookStatements(function, dataflow_, parent.hooks())),
     definition_(nullptr)
 {
@@ -1259,7 +1260,7 @@ bool DefinitionGenerator::computeIsSubstituted(const Term *write) {
 
     std::size_t nuses = 0;
 
-    foreach (const auto &use, uses_->getUses(write)) {
+    foreach (const auto &use, uses_.getUses(write)) {
         auto read = use.term();
 
         if (liveness_.isLive(read)) {
@@ -1273,7 +1274,7 @@ bool DefinitionGenerator::computeIsSubstituted(const Term *write) {
             }
             assert(theOnlyDefinition == write);
 
-            if (!isDominating(write->statement(), read->statement(), *dominators_)) {
+            if (!isDominating(write->statement(), read->statement(), dominators_)) {
                 return false;
             }
 
@@ -1332,7 +1333,7 @@ bool DefinitionGenerator::canBeMoved(const Term *term, const Statement *destinat
                  */
                 return variable->isLocal() &&
                      allOfStatementsBetween(
-                        term->statement(), destination, *cfg_,
+                        term->statement(), destination, cfg_,
                         [&](const Statement *statement) -> bool {
                             auto term = getWrittenTerm(statement);
                             return !term || parent().variables().getVariable(term) != variable;
@@ -1341,7 +1342,7 @@ bool DefinitionGenerator::canBeMoved(const Term *term, const Statement *destinat
 
             Domain domain = *getDomain(term);
             return allOfStatementsBetween(
-                term->statement(), destination, *cfg_,
+                term->statement(), destination, cfg_,
                 [&](const Statement *statement) -> bool {
                     auto term = getWrittenTerm(statement);
                     return !term || getDomain(term) != domain;
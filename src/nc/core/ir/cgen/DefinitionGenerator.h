@@ -86,9 +86,9 @@ class DefinitionGenerator: public DeclarationGenerator {
     const dflow::Dataflow &dataflow_;
     const cflow::Graph &graph_;
     const liveness::Liveness &liveness_;
-    std::unique_ptr<dflow::Uses> uses_;
-    std::unique_ptr<CFG> cfg_;
-    std::unique_ptr<Dominators> dominators_;
+    const dflow::Uses &uses_;
+    const CFG &cfg_;
+    const Dominators &dominators_;
     boost::unordered_set<const Statement *> hookStatements_;
 
     likec::FunctionDefinition *definition_;
@@ -27,11 +27,9 @@
 
 #include <memory>
 
-#include <boost/unordered_map.hpp>
-
-#include <nc/common/Range.h>
-
+#include <nc/core/ir/DenseMap.h>
 #include <nc/core/ir/MemoryLocation.h>
+#include <nc/core/ir/Statement.h>
 #include <nc/core/ir/Term.h>
 
 #include "ReachingDefinitions.h"
@@ -45,19 +43,22 @@ class Value;
 
 /**
  * This class contains results of dataflow and constant propagation and folding analysis.
+ *
+ * The results are stored in arrays indexed by the indices that the function
+ * assigns to its terms and statements.
  */
 class Dataflow {
     /** Mapping from a term to a description of its value. */
-    boost::unordered_map<const Term *, std::unique_ptr<Value>> term2value_;
+    DenseMap<Term, std::unique_ptr<Value>> term2value_;
 
     /** Mapping from a term to its memory location. */
-    boost::unordered_map<const Term *, MemoryLocation> term2location_;
+    DenseMap<Term, MemoryLocation> term2location_;
 
     /** Mapping from a term to the reaching definitions. */
-    boost::unordered_map<const Term *, ReachingDefinitions> term2definitions_;
+    DenseMap<Term, ReachingDefinitions> term2definitions_;
 
     /** Mapping from a statement to the reaching definitions. */
-    boost::unordered_map<const Statement *, ReachingDefinitions> statement2definitions_;
+    DenseMap<Statement, ReachingDefinitions> statement2definitions_;
 
 public:
     /**
@@ -91,12 +92,12 @@ public:
     /**
      * \return Mapping from a term to the description of its value.
      */
-    boost::unordered_map<const Term *, std::unique_ptr<Value>> &term2value() { return term2value_; }
+    DenseMap<Term, std::unique_ptr<Value>> &term2value() { return term2value_; }
 
     /**
      * \return Mapping from a term to the description of its value.
      */
-    const boost::unordered_map<const Term *, std::unique_ptr<Value>> &term2value() const { return term2value_; }
+    const DenseMap<Term, std::unique_ptr<Value>> &term2value() const { return term2value_; }
 
     /**
      * \param[in] term Valid pointer to a term.
@@ -106,7 +107,7 @@ public:
      */
     const ir::MemoryLocation &getMemoryLocation(const Term *term) const {
         assert(term != nullptr);
-        return nc::find(term2location_, term);
+        return term2location_.get(term);
     }
 
     /**
@@ -125,12 +126,12 @@ public:
     /**
      * \return Mapping from a term to its memory location.
      */
-    boost::unordered_map<const Term *, MemoryLocation> &term2location() { return term2location_; };
+    DenseMap<Term, MemoryLocation> &term2location() { return term2location_; };
 
     /**
      * \return Mapping from a term to its memory location.
      */
-    const boost::unordered_map<const Term *, MemoryLocation> &term2location() const { return term2location_; };
+    const DenseMap<Term, MemoryLocation> &term2location() const { return term2location_; };
 
     /**
      * \param[in] term Valid pointer to a read term.
@@ -151,18 +152,18 @@ public:
     const ReachingDefinitions &getDefinitions(const Term *term) const {
         assert(term != nullptr);
         assert(term->isRead());
-        return nc::find(term2definitions_, term);
+        return term2definitions_.get(term);
     }
 
     /**
      * \return Mapping from a term to its reaching definitions.
      */
-    boost::unordered_map<const Term *, ReachingDefinitions> &term2definitions() { return term2definitions_; }
+    DenseMap<Term, ReachingDefinitions> &term2definitions() { return term2definitions_; }
 
     /**
      * \return Mapping from a term to its reaching definitions.
      */
-    const boost::unordered_map<const Term *, ReachingDefinitions> &term2definitions() const { return term2definitions_; }
+    const DenseMap<Term, ReachingDefinitions> &term2definitions() const { return term2definitions_; }
 
     /**
      * \param[in] statement Valid pointer to a read statement.
@@ -181,7 +182,7 @@ public:
      */
     const ReachingDefinitions &getDefinitions(const Statement *statement) const {
         assert(statement != nullptr);
-        return nc::find(statement2definitions_, statement);
+        return statement2definitions_.get(statement);
     }
 };
 
@@ -24,7 +24,7 @@
 
 #include "DataflowAnalyzer.h"
 
-#include <boost/unordered_map.hpp>
+#include <algorithm>
 
 #include <nc/common/CancellationToken.h>
 #include <nc/common/Foreach.h>
@@ -48,18 +48,48 @@ namespace dflow {
 
 namespace {
 
-template<class Map, class Pred>
-void remove_if(Map &map, Pred pred) {
-    auto i = map.begin();
-    auto iend = map.end();
+/**
+ * \param cfg Control flow graph.
+ *
+ * \return Indices of all basic blocks of the graph in reverse postorder
+ *         of a depth-first search started from each unvisited block
+ *         in the order of the blocks in the graph.
+ */
+std::vector<std::size_t> getReversePostorder(const CFG &cfg) {
+    std::vector<std::size_t> result;
+    result.reserve(cfg.basicBlockCount());
+
+    std::vector<char> visited(cfg.basicBlockCount(), false);
+    std::vector<std::pair<std::size_t, std::size_t>> stack;
+
+    for (std::size_t root = 0; root < cfg.basicBlockCount(); ++root) {
+        if (visited[root]) {
+            continue;
+        }
+        visited[root] = true;
 
-    while (i != iend) {
-        if (pred(i->first)) {
-            i = map.erase(i);
-        } else {
-            ++i;
+        stack.push_back(std::make_pair(root, 0));
+
+        while (!stack.empty()) {
+            auto basicBlock = stack.back().first;
+            auto successors = cfg.getSuccessorIndices(basicBlock);
+
+            if (stack.back().second < static_cast<std::size_t>(successors.size())) {
+                auto successor = successors[stack.back().second++];
+                if (!visited[successor]) {
+                    visited[successor] = true;
+                    stack.push_back(std::make_pair(successor, 0));
+                }
+            } else {
+                result.push_back(basicBlock);
+                stack.pop_back();
+            }
         }
     }
+
+    std::reverse(result.begin(), result.end());
+
+    return result;
 }
 
 } // anonymous namespace
@@ -72,75 +102,123 @@ void DataflowAnalyzer::analyze(const CFG &cfg) {
         return !dataflow().getMemoryLocation(term).covers(mloc);
     };
 
-    /* Mapping of a basic block to the definitions reaching its end. */
-    boost::unordered_map<const BasicBlock *, ReachingDefinitions> outDefinitions;
+    /* Indices of basic blocks in the CFG, in the order of execution. */
+    auto basicBlocks = getReversePostorder(cfg);
+
+    /* Mapping from the index of a basic block in the CFG to its position in the order of execution. */
+    std::vector<std::size_t> block2index(basicBlocks.size());
+    for (std::size_t i = 0; i < basicBlocks.size(); ++i) {
+        block2index[basicBlocks[i]] = i;
+    }
+
+    /* Definitions reaching the end of each basic block. */
+    std::vector<ReachingDefinitions> outDefinitions(basicBlocks.size());
+
+    /* Basic blocks waiting to be executed. Initially, all of them. */
+    std::vector<char> queued(basicBlocks.size(), true);
+    std::size_t nqueued = basicBlocks.size();
+
+    auto enqueue = [&](std::size_t basicBlock) {
+        auto &flag = queued[block2index[basicBlock]];
+        if (!flag) {
+            flag = true;
+            ++nqueued;
+        }
+    };
+
+    definition2readers_.clear();
+    iterationCount_ = 0;
+    blockExecutionCount_ = 0;
 
     /*
-     * Running abstract interpretation until reaching a fixpoint several times in a row.
+     * Running abstract interpretation of the queued basic blocks until nothing changes.
      */
-    int niterations = 0;
-    int nfixpoints = 0;
+    while (nqueued > 0) {
+        for (std::size_t i = 0; i < basicBlocks.size(); ++i) {
+            if (!queued[i]) {
+                continue;
+            }
+            queued[i] = false;
+            --nqueued;
+            ++blockExecutionCount_;
+
+            auto basicBlock = cfg.getBasicBlock(basicBlocks[i]);
 
-    while (nfixpoints++ < 3) {
-        /*
-         * Run abstract interpretation on all basic blocks.
-         */
-        foreach (auto basicBlock, cfg.basicBlocks()) {
             ReachingDefinitions definitions;
 
             /* Merge reaching definitions from predecessors. */
-            foreach (const BasicBlock *predecessor, cfg.getPredecessors(basicBlock)) {
-                definitions.merge(outDefinitions[predecessor]);
+            foreach (auto predecessor, cfg.getPredecessorIndices(basicBlocks[i])) {
+                definitions.merge(outDefinitions[block2index[predecessor]]);
             }
 
             /* Remove definitions that do not cover the memory location that they define. */
             definitions.filterOut(notCovered);
 
             /* Execute all the statements in the basic block. */
+            changedDefinitions_.clear();
             foreach (auto statement, basicBlock->statements()) {
                 execute(statement, definitions);
             }
 
-            /* Something has changed? */
-            ReachingDefinitions &oldDefinitions(outDefinitions[basicBlock]);
-            if (oldDefinitions != definitions) {
-                oldDefinitions = std::move(definitions);
-                nfixpoints = 0;
+            /* Something has changed? Reexecute the successors. */
+            if (outDefinitions[i] != definitions) {
+                outDefinitions[i] = std::move(definitions);
+
+                foreach (auto successor, cfg.getSuccessorIndices(basicBlocks[i])) {
+                    enqueue(successor);
+                }
             }
-        }
 
-        /*
-         * Some terms might have changed their addresses. Filter again.
-         */
-        foreach (auto &termAndDefinitions, dataflow().term2definitions()) {
-            termAndDefinitions.second.filterOut(notCovered);
+            /* Reexecute the basic blocks using the changed definitions. */
+            foreach (auto definition, changedDefinitions_) {
+                auto readers = definition2readers_.find(definition);
+                if (readers != definition2readers_.end()) {
+                    foreach (auto reader, readers->second) {
+                        enqueue(cfg.getIndex(reader));
+                    }
+                }
+            }
         }
 
         /*
          * Do we loop infinitely?
          */
-        if (++niterations >= 30) {
-            log_.warning(tr("%1: Fixpoint was not reached after %2 iterations.").arg(Q_FUNC_INFO).arg(niterations));
+        if (++iterationCount_ >= 30 && nqueued > 0) {
+            log_.warning(tr("%1: Fixpoint was not reached after %2 iterations.").arg(Q_FUNC_INFO).arg(iterationCount_));
             break;
         }
 
         canceled_.poll();
     }
 
+    log_.debug([&]() {
+        return tr("Dataflow analysis took %1 iterations and %2 executions of %3 basic blocks.")
+            .arg(iterationCount_).arg(blockExecutionCount_).arg(basicBlocks.size());
+    });
+
+    definition2readers_.clear();
+    definition2list_.clear();
+
+    /*
+     * Some terms might have changed their addresses. Filter again.
+     */
+    dataflow().term2definitions().forEach([&](const Term *, ReachingDefinitions &definitions) {
+        definitions.filterOut(notCovered);
+    });
+
     /*
      * Remove information about terms that disappeared.
      * Terms can disappear if e.g. a call is deinstrumented during the analysis.
      */
     auto disappeared = [](const Term *term){ return term->statement()->basicBlock() == nullptr; };
 
-    std::vector<const Term *> disappearedTerms;
-    foreach (auto &termAndDefinitions, dataflow().term2definitions()) {
-        termAndDefinitions.second.filterOut([disappeared](const MemoryLocation &, const Term *term) { return disappeared(term); } );
-    }
+    dataflow().term2definitions().forEach([disappeared](const Term *, ReachingDefinitions &definitions) {
+        definitions.filterOut([disappeared](const MemoryLocation &, const Term *term) { return disappeared(term); } );
+    });
 
-    remove_if(dataflow().term2value(), disappeared);
-    remove_if(dataflow().term2location(), disappeared);
-    remove_if(dataflow().term2definitions(), disappeared);
+    dataflow().term2value().removeIf(disappeared);
+    dataflow().term2location().removeIf(disappeared);
+    dataflow().term2definitions().removeIf(disappeared);
 }
 
 void DataflowAnalyzer::execute(const Statement *statement, ReachingDefinitions &definitions) {
@@ -153,8 +231,16 @@ void DataflowAnalyzer::execute(const Statement *statement, ReachingDefinitions &
             break;
         case Statement::ASSIGNMENT: {
             auto assignment = statement->asAssignment();
+            auto value = dataflow().getValue(assignment->left());
+            auto oldValue = *value;
+            auto oldMemoryLocation = dataflow().getMemoryLocation(assignment->left());
+
             computeValue(assignment->right(), definitions);
             handleWrite(assignment->left(), computeMemoryLocation(assignment->left(), definitions), definitions);
+
+            if (*value != oldValue || dataflow().getMemoryLocation(assignment->left()) != oldMemoryLocation) {
+                changedDefinitions_.push_back(assignment->left());
+            }
             break;
         }
         case Statement::JUMP: {
@@ -185,9 +271,14 @@ void DataflowAnalyzer::execute(const Statement *statement, ReachingDefinitions &
                 case Term::READ:
                     computeValue(touch->term(), definitions);
                     break;
-                case Term::WRITE:
+                case Term::WRITE: {
+                    auto oldMemoryLocation = dataflow().getMemoryLocation(touch->term());
                     handleWrite(touch->term(), computeMemoryLocation(touch->term(), definitions), definitions);
+                    if (dataflow().getMemoryLocation(touch->term()) != oldMemoryLocation) {
+                        changedDefinitions_.push_back(touch->term());
+                    }
                     break;
+                }
                 default:
                     unreachable();
             }
@@ -313,6 +404,15 @@ const ReachingDefinitions &DataflowAnalyzer::computeReachingDefinitions(const Te
 
     if (isTracked(memoryLocation)) {
         definitions.project(memoryLocation, termDefinitions);
+
+        /* Remember where the definitions are used, to reexecute these places when the definitions change. */
+        if (auto basicBlock = term->statement()->basicBlock()) {
+            foreach (const auto &chunk, termDefinitions.chunks()) {
+                foreach (auto definition, chunk.definitions()) {
+                    definition2readers_[definition].insert(basicBlock);
+                }
+            }
+        }
     } else {
         termDefinitions.clear();
     }
@@ -609,7 +709,11 @@ void DataflowAnalyzer::handleWrite(const Term *term, const MemoryLocation &memor
     );
 
     if (isTracked(memoryLocation)) {
-        definitions.addDefinition(memoryLocation, term);
+        auto &list = definition2list_[term];
+        if (!list) {
+            list = std::make_shared<const std::vector<const Term *>>(1, term);
+        }
+        definitions.addDefinition(memoryLocation, list);
     }
 }
 
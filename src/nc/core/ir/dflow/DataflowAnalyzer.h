@@ -31,6 +31,11 @@
 #include <nc/common/LogToken.h>
 
 #include <cassert>
+#include <memory>
+#include <vector>
+
+#include <boost/unordered_map.hpp>
+#include <boost/unordered_set.hpp>
 
 namespace nc {
 
@@ -42,6 +47,7 @@ namespace arch {
 
 namespace ir {
 
+class BasicBlock;
 class CFG;
 class MemoryLocation;
 class Statement;
@@ -67,6 +73,25 @@ class DataflowAnalyzer {
     const CancellationToken &canceled_;
     const LogToken &log_;
 
+    /** Write terms whose value or memory location changed since the last clear. */
+    std::vector<const Term *> changedDefinitions_;
+
+    /** Mapping from a write term to the basic blocks containing its uses. Filled in by analyze(). */
+    boost::unordered_map<const Term *, boost::unordered_set<const BasicBlock *>> definition2readers_;
+
+    /**
+     * Mapping from a write term to the list consisting of this term only.
+     * Using the same list for every definition by the term lets reaching
+     * definitions be compared by pointer.
+     */
+    boost::unordered_map<const Term *, std::shared_ptr<const std::vector<const Term *>>> definition2list_;
+
+    /** Number of passes over the queued basic blocks done by the last analyze() call. */
+    int iterationCount_;
+
+    /** Number of basic block executions done by the last analyze() call. */
+    int blockExecutionCount_;
+
 public:
     /**
      * Constructor.
@@ -78,7 +103,8 @@ public:
      */
     DataflowAnalyzer(Dataflow &dataflow, const arch::Architecture *architecture,
         const CancellationToken &canceled, const LogToken &log):
-        dataflow_(dataflow), architecture_(architecture), canceled_(canceled), log_(log)
+        dataflow_(dataflow), architecture_(architecture), canceled_(canceled), log_(log),
+        iterationCount_(0), blockExecutionCount_(0)
     {
         assert(architecture != nullptr);
     }
@@ -97,10 +123,25 @@ public:
      * Performs joint reaching definitions and constant propagation/folding
      * analysis on the given control flow graph.
      *
+     * Basic blocks are executed in reverse postorder. A basic block is
+     * executed again only if the definitions reaching its end changed
+     * in one of its predecessors, or if the value or the memory location
+     * of a definition used in it changed.
+     *
      * \param[in] cfg Control flow graph to run dataflow analysis on.
      */
     void analyze(const CFG &cfg);
 
+    /**
+     * \return Number of passes over the queued basic blocks done by the last analyze() call.
+     */
+    int iterationCount() const { return iterationCount_; }
+
+    /**
+     * \return Number of basic block executions done by the last analyze() call.
+     */
+    int blockExecutionCount() const { return blockExecutionCount_; }
+
     /**
      * Executes a statement.
      *
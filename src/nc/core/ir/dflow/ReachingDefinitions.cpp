@@ -38,17 +38,29 @@ namespace core {
 namespace ir {
 namespace dflow {
 
+const std::vector<ReachingDefinitions::Chunk> &ReachingDefinitions::emptyChunks() {
+    static const std::vector<Chunk> result;
+    return result;
+}
+
 void ReachingDefinitions::addDefinition(const MemoryLocation &mloc, const Term *term) {
+    addDefinition(mloc, std::make_shared<const std::vector<const Term *>>(1, term));
+}
+
+void ReachingDefinitions::addDefinition(const MemoryLocation &mloc, SharedDefinitions definitions) {
     assert(mloc);
+    assert(definitions);
 
     killDefinitions(mloc);
-    
-    auto i = std::lower_bound(chunks_.begin(), chunks_.end(), mloc,
+
+    auto &chunks = mutableChunks();
+
+    auto i = std::lower_bound(chunks.begin(), chunks.end(), mloc,
         [](const Chunk &a, const MemoryLocation &b) -> bool {
             return a.location() < b;
         });
 
-    chunks_.insert(i, Chunk(mloc, std::vector<const Term *>(1, term)));
+    chunks.insert(i, Chunk(mloc, std::move(definitions)));
 
     selfTest();
 }
@@ -56,67 +68,72 @@ void ReachingDefinitions::addDefinition(const MemoryLocation &mloc, const Term *
 void ReachingDefinitions::killDefinitions(const MemoryLocation &mloc) {
     assert(mloc);
 
-    if (chunks_.empty()) {
+    const auto &chunks = this->chunks();
+
+    if (std::none_of(chunks.begin(), chunks.end(),
+            [&mloc](const Chunk &chunk) { return mloc.overlaps(chunk.location()); })) {
         return;
     }
 
     std::vector<Chunk> result;
-    result.reserve(chunks_.size() + 1);
+    result.reserve(chunks.size() + 1);
 
-    foreach (auto &chunk, chunks_) {
+    foreach (const auto &chunk, chunks) {
         if (!mloc.overlaps(chunk.location())) {
-            result.push_back(std::move(chunk));
+            result.push_back(chunk);
         } else {
             if (chunk.location().addr() < mloc.addr()) {
-                if (mloc.endAddr() < chunk.location().endAddr()) {
-                    result.push_back(Chunk(
-                        MemoryLocation(mloc.domain(), chunk.location().addr(), mloc.addr() - chunk.location().addr()),
-                        chunk.definitions()));
-                } else {
-                    result.push_back(Chunk(
-                        MemoryLocation(mloc.domain(), chunk.location().addr(), mloc.addr() - chunk.location().addr()),
-                        std::move(chunk.definitions())));
-                }
+                result.push_back(Chunk(
+                    MemoryLocation(mloc.domain(), chunk.location().addr(), mloc.addr() - chunk.location().addr()),
+                    chunk.sharedDefinitions()));
             }
             if (mloc.endAddr() < chunk.location().endAddr()) {
                 result.push_back(Chunk(
                     MemoryLocation(mloc.domain(), mloc.endAddr(), chunk.location().endAddr() - mloc.endAddr()),
-                    std::move(chunk.definitions())));
+                    chunk.sharedDefinitions()));
             }
         }
     }
 
-    chunks_ = std::move(result);
+    setChunks(std::move(result));
 
     selfTest();
 }
 
 void ReachingDefinitions::project(const MemoryLocation &mloc, ReachingDefinitions &result) const {
     assert(mloc);
+    assert(&result != this);
 
-    result.clear();
+    std::vector<Chunk> chunks;
 
-    foreach (const auto &chunk, chunks_) {
+    foreach (const auto &chunk, this->chunks()) {
         if (chunk.location().domain() == mloc.domain()) {
             auto addr = std::max(chunk.location().addr(), mloc.addr());
             auto endAddr = std::min(chunk.location().endAddr(), mloc.endAddr());
 
             if (addr < endAddr) {
-                result.chunks_.push_back(Chunk(
+                chunks.push_back(Chunk(
                     MemoryLocation(mloc.domain(), addr, endAddr - addr),
-                    chunk.definitions()));
+                    chunk.sharedDefinitions()));
             }
         }
     }
 
+    /* Keep sharing the old list if the projection has not changed. */
+    if (chunks.empty()) {
+        result.clear();
+    } else if (chunks != result.chunks()) {
+        result.setChunks(std::move(chunks));
+    }
+
     result.selfTest();
 }
 
 std::vector<MemoryLocation> ReachingDefinitions::getDefinedMemoryLocationsWithin(Domain domain) const {
     std::vector<MemoryLocation> result;
-    result.reserve(chunks_.size());
+    result.reserve(chunks().size());
 
-    foreach (const auto &chunk, chunks_) {
+    foreach (const auto &chunk, chunks()) {
         if (chunk.location().domain() == domain) {
             result.push_back(chunk.location());
         }
@@ -125,17 +142,53 @@ std::vector<MemoryLocation> ReachingDefinitions::getDefinedMemoryLocationsWithin
     return result;
 }
 
+namespace {
+
+/**
+ * \param a Valid pointer to a sorted list of terms.
+ * \param b Valid pointer to a sorted list of terms.
+ *
+ * \return Valid pointer to the union of the two lists.
+ *         If the union is equal to one of the lists, this list is returned.
+ */
+ReachingDefinitions::SharedDefinitions unite(const ReachingDefinitions::SharedDefinitions &a,
+                                             const ReachingDefinitions::SharedDefinitions &b)
+{
+    if (a == b || std::includes(a->begin(), a->end(), b->begin(), b->end())) {
+        return a;
+    }
+    if (std::includes(b->begin(), b->end(), a->begin(), a->end())) {
+        return b;
+    }
+
+    std::vector<const Term *> merged;
+    merged.reserve(a->size() + b->size());
+    std::set_union(a->begin(), a->end(), b->begin(), b->end(), std::back_inserter(merged));
+
+    return std::make_shared<const std::vector<const Term *>>(std::move(merged));
+}
+
+} // anonymous namespace
+
 void ReachingDefinitions::merge(const ReachingDefinitions &those) {
     selfTest();
 
+    if (chunks_ == those.chunks_ || those.empty()) {
+        return;
+    }
+    if (empty()) {
+        chunks_ = those.chunks_;
+        return;
+    }
+
     std::vector<Chunk> result;
-    result.reserve(chunks_.size() + those.chunks_.size());
+    result.reserve(chunks_->size() + those.chunks_->size());
 
-    auto i = chunks_.begin();
-    auto iend = chunks_.end();
+    auto i = chunks_->cbegin();
+    auto iend = chunks_->cend();
 
-    auto j = those.chunks_.begin();
-    auto jend = those.chunks_.end();
+    auto j = those.chunks_->cbegin();
+    auto jend = those.chunks_->cend();
 
     while (i != iend || j != jend) {
         auto a = i != iend ? i->location() : MemoryLocation();
@@ -152,31 +205,29 @@ void ReachingDefinitions::merge(const ReachingDefinitions &those) {
         }
 
         if (!b) {
-            result.push_back(Chunk(a, i->definitions()));
+            result.push_back(Chunk(a, i->sharedDefinitions()));
             ++i;
         } else if (!a) {
-            result.push_back(Chunk(b, j->definitions()));
+            result.push_back(Chunk(b, j->sharedDefinitions()));
             ++j;
         } else if (a.domain() < b.domain()) {
-            result.push_back(Chunk(a, i->definitions()));
+            result.push_back(Chunk(a, i->sharedDefinitions()));
             ++i;
         } else if (b.domain() < a.domain()) {
-            result.push_back(Chunk(b, j->definitions()));
+            result.push_back(Chunk(b, j->sharedDefinitions()));
             ++j;
         } else if (a.endAddr() <= b.addr()) {
-            result.push_back(Chunk(a, i->definitions()));
+            result.push_back(Chunk(a, i->sharedDefinitions()));
             ++i;
         } else if (b.endAddr() <= a.addr()) {
-            result.push_back(Chunk(b, j->definitions()));
+            result.push_back(Chunk(b, j->sharedDefinitions()));
             ++j;
         } else if (a.addr() < b.addr()) {
-            result.push_back(Chunk(MemoryLocation(a.domain(), a.addr(), b.addr() - a.addr()), i->definitions()));
+            result.push_back(Chunk(MemoryLocation(a.domain(), a.addr(), b.addr() - a.addr()), i->sharedDefinitions()));
         } else if (b.addr() < a.addr()) {
-            result.push_back(Chunk(MemoryLocation(b.domain(), b.addr(), a.addr() - b.addr()), j->definitions()));
+            result.push_back(Chunk(MemoryLocation(b.domain(), b.addr(), a.addr() - b.addr()), j->sharedDefinitions()));
         } else {
-            std::vector<const Term *> merged;
-            merged.reserve(i->definitions().size() + j->definitions().size());
-            std::set_union(i->definitions().begin(), i->definitions().end(), j->definitions().begin(), j->definitions().end(), std::back_inserter(merged));
+            auto merged = unite(i->sharedDefinitions(), j->sharedDefinitions());
 
             if (a.size() < b.size()) {
                 result.push_back(Chunk(a, std::move(merged)));
@@ -192,14 +243,17 @@ void ReachingDefinitions::merge(const ReachingDefinitions &those) {
         }
     }
 
-    chunks_ = std::move(result);
+    /* Keep sharing the old list if nothing has changed. */
+    if (result != *chunks_) {
+        setChunks(std::move(result));
+    }
 
     selfTest();
 }
 
 void ReachingDefinitions::print(QTextStream &out) const {
     out << '{';
-    foreach (const auto &chunk, chunks_) {
+    foreach (const auto &chunk, chunks()) {
         out << chunk.location() << ':';
         foreach (const Term *term, chunk.definitions()) {
             out << ' ' << *term;
@@ -27,6 +27,8 @@
 
 #include <algorithm>
 #include <cassert>
+#include <iterator>
+#include <memory>
 #include <vector>
 
 #include <nc/common/Foreach.h>
@@ -44,18 +46,42 @@ namespace dflow {
 
 /**
  * Reaching definitions.
+ *
+ * The data structure is copy-on-write: copies share the list of chunks
+ * until one of them is modified, and chunks share their (immutable) lists
+ * of definitions. Operations reuse the lists of their arguments whenever
+ * the result is the same, so that equal lists are usually the same object
+ * and can be compared by pointer.
  */
 class ReachingDefinitions: public PrintableBase<ReachingDefinitions> {
 public:
+    /**
+     * Immutable sorted list of terms, shared between chunks.
+     */
+    typedef std::shared_ptr<const std::vector<const Term *>> SharedDefinitions;
+
     /*
      * Memory location and the list of terms defining this memory location.
      */
     class Chunk {
         MemoryLocation location_; ///< Memory location.
-        std::vector<const Term *> definitions_; ///< Terms defining this memory location.
+        SharedDefinitions definitions_; ///< Terms defining this memory location.
 
         public:
 
+        /*
+         * Constructor.
+         *
+         * \param location      Valid memory location.
+         * \param definitions   Valid pointer to the list of terms defining this memory location.
+         */
+        Chunk(const MemoryLocation &location, SharedDefinitions definitions):
+            location_(location), definitions_(std::move(definitions))
+        {
+            assert(location);
+            assert(definitions_);
+        }
+
         /*
          * Constructor.
          *
@@ -63,7 +89,7 @@ public:
          * \param definitions   List of terms defining this memory location.
          */
         Chunk(const MemoryLocation &location, std::vector<const Term *> definitions):
-            location_(location), definitions_(std::move(definitions))
+            location_(location), definitions_(std::make_shared<const std::vector<const Term *>>(std::move(definitions)))
         {
             assert(location);
         }
@@ -76,12 +102,12 @@ public:
         /**
          * \return List of terms defining the memory location.
          */
-        std::vector<const Term *> &definitions() { return definitions_; }
+        const std::vector<const Term *> &definitions() const { return *definitions_; }
 
         /**
-         * \return List of terms defining the memory location.
+         * \return Valid pointer to the shared list of terms defining the memory location.
          */
-        const std::vector<const Term *> &definitions() const { return definitions_; }
+        const SharedDefinitions &sharedDefinitions() const { return definitions_; }
 
         /**
          * \param that Another object of the same type.
@@ -90,7 +116,8 @@ public:
          *         false otherwise.
          */
         bool operator==(const Chunk &that) const {
-            return location_ == that.location_ && definitions_ == that.definitions_;
+            return location_ == that.location_ &&
+                (definitions_ == that.definitions_ || *definitions_ == *that.definitions_);
         }
     };
 
@@ -99,8 +126,10 @@ private:
      * Pairs of memory locations and terms defining them.
      * The pairs are sorted by memory location.
      * Terms are sorted using default comparator.
+     * Can be nullptr, which means no chunks.
+     * Can be shared with other instances, and must be copied before modification.
      */
-    std::vector<Chunk> chunks_;
+    std::shared_ptr<std::vector<Chunk>> chunks_;
 
 public:
     /**
@@ -108,17 +137,17 @@ public:
      *         The pairs are sorted by memory location.
      *         Terms are sorted using default comparator.
      */
-    const std::vector<Chunk> &chunks() const { return chunks_; }
+    const std::vector<Chunk> &chunks() const { return chunks_ ? *chunks_ : emptyChunks(); }
 
     /**
      * \return True if the list of pairs (chunks) is empty, false otherwise.
      */
-    bool empty() const { return chunks_.empty(); }
+    bool empty() const { return !chunks_ || chunks_->empty(); }
 
     /**
      * Clears the reaching definitions.
      */
-    void clear() { chunks_.clear(); }
+    void clear() { chunks_.reset(); }
 
     /**
      * Adds a definition of memory location, removing all previous definitions of overlapping memory locations.
@@ -128,6 +157,16 @@ public:
      */
     void addDefinition(const MemoryLocation &memoryLocation, const Term *term);
 
+    /**
+     * Adds a definition of memory location, removing all previous definitions of overlapping memory locations.
+     *
+     * \param[in] memoryLocation Memory location.
+     * \param[in] definitions Valid pointer to a list of terms defining the memory location.
+     *                        Passing the same list for the same term every time
+     *                        makes comparisons of reaching definitions cheaper.
+     */
+    void addDefinition(const MemoryLocation &memoryLocation, SharedDefinitions definitions);
+
     /**
      * Kills definitions of given memory location.
      *
@@ -177,7 +216,9 @@ public:
      *
      * \param[in] those Reaching definitions.
      */
-    bool operator==(const ReachingDefinitions &those) const { return chunks_ == those.chunks_; }
+    bool operator==(const ReachingDefinitions &those) const {
+        return chunks_ == those.chunks_ || chunks() == those.chunks();
+    }
 
     /**
      * \return True, if these and given reaching definitions are different.
@@ -196,30 +237,83 @@ public:
     template<class T>
     void filterOut(const T &pred) {
         selfTest();
-        foreach (auto &chunk, chunks_) {
-            chunk.definitions().erase(
-                std::remove_if(chunk.definitions().begin(), chunk.definitions().end(),
-                    [&](const Term *term) -> bool { return pred(chunk.location(), term); }),
-                chunk.definitions().end());
+
+        if (empty()) {
+            return;
         }
-        chunks_.erase(
-            std::remove_if(chunks_.begin(), chunks_.end(),
-                [](const Chunk &chunk) -> bool { return chunk.definitions().empty(); }),
-            chunks_.end());
+
+        /* Lists of definitions and chunks are copied only if something is actually removed. */
+        bool changed = false;
+        for (std::size_t i = 0; i < chunks_->size(); ++i) {
+            auto location = (*chunks_)[i].location();
+            const auto &definitions = (*chunks_)[i].definitions();
+
+            auto predicate = [&](const Term *term) -> bool { return pred(location, term); };
+
+            if (std::none_of(definitions.begin(), definitions.end(), predicate)) {
+                continue;
+            }
+
+            std::vector<const Term *> filtered;
+            filtered.reserve(definitions.size());
+            std::remove_copy_if(definitions.begin(), definitions.end(), std::back_inserter(filtered), predicate);
+
+            mutableChunks()[i] = Chunk(location, std::move(filtered));
+            changed = true;
+        }
+
+        if (changed) {
+            chunks_->erase(
+                std::remove_if(chunks_->begin(), chunks_->end(),
+                    [](const Chunk &chunk) -> bool { return chunk.definitions().empty(); }),
+                chunks_->end());
+        }
+
         selfTest();
     }
 
     void print(QTextStream &out) const;
 
 private:
+    /**
+     * \return Reference to an empty list of chunks.
+     */
+    static const std::vector<Chunk> &emptyChunks();
+
+    /**
+     * \return Reference to the list of chunks owned exclusively by this object.
+     */
+    std::vector<Chunk> &mutableChunks() {
+        if (!chunks_) {
+            chunks_ = std::make_shared<std::vector<Chunk>>();
+        } else if (chunks_.use_count() > 1) {
+            chunks_ = std::make_shared<std::vector<Chunk>>(*chunks_);
+        }
+        return *chunks_;
+    }
+
+    /**
+     * Replaces the list of chunks by the given one.
+     *
+     * \param chunks Sorted list of chunks.
+     */
+    void setChunks(std::vector<Chunk> chunks) {
+        if (chunks_ && chunks_.use_count() == 1) {
+            *chunks_ = std::move(chunks);
+        } else {
+            chunks_ = std::make_shared<std::vector<Chunk>>(std::move(chunks));
+        }
+    }
+
     /**
      * Checks if the data structure is in a valid state.
      * Fails with an assertion if not.
      */
     void selfTest() const {
 #ifndef NDEBUG
-        for (std::size_t i = 1; i < chunks_.size(); ++i) {
-            assert(chunks_[i-1].location() < chunks_[i].location());
+        const auto &chunks = this->chunks();
+        for (std::size_t i = 1; i < chunks.size(); ++i) {
+            assert(chunks[i-1].location() < chunks[i].location());
         }
 #endif
     }
@@ -13,13 +13,13 @@ namespace ir {
 namespace dflow {
 
 Uses::Uses(const Dataflow &dataflow) {
-    foreach (auto &termAndDefinitions, dataflow.term2definitions()) {
-        foreach (const auto &chunk, termAndDefinitions.second.chunks()) {
+    dataflow.term2definitions().forEach([this](const Term *term, const ReachingDefinitions &definitions) {
+        foreach (const auto &chunk, definitions.chunks()) {
             foreach (const Term *definition, chunk.definitions()) {
-                term2uses_[definition].push_back(Use(chunk.location(), termAndDefinitions.first));
+                term2uses_[definition].push_back(Use(chunk.location(), term));
             }
         }
-    }
+    });
 }
 
 } // namespace dflow
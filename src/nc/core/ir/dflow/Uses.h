@@ -7,10 +7,7 @@
 
 #include <vector>
 
-#include <boost/unordered_map.hpp>
-
-#include <nc/common/Range.h>
-
+#include <nc/core/ir/DenseMap.h>
 #include <nc/core/ir/Term.h>
 
 namespace nc {
@@ -47,7 +44,7 @@ public:
 
 private:
     /** Mapping from a write term to the list of its uses. */
-    boost::unordered_map<const Term *, std::vector<Use>> term2uses_;
+    DenseMap<Term, std::vector<Use>> term2uses_;
 
 public:
     /**
@@ -66,7 +63,7 @@ public:
     const std::vector<Use> &getUses(const Term *term) const {
         assert(term != nullptr);
         assert(term->isWrite());
-        return nc::find(term2uses_, term);
+        return term2uses_.get(term);
     }
 };
 
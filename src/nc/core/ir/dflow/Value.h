@@ -143,6 +143,31 @@ public:
      * Marks the value as being not a return address.
      */
     void makeNotReturnAddress() { isNotReturnAddress_ = true; }
+
+    /**
+     * \param that Another value.
+     *
+     * \return True if both values carry exactly the same information, false otherwise.
+     */
+    bool operator==(const Value &that) const {
+        return abstractValue_.size() == that.abstractValue_.size() &&
+               abstractValue_.zeroBits() == that.abstractValue_.zeroBits() &&
+               abstractValue_.oneBits() == that.abstractValue_.oneBits() &&
+               isStackOffset_ == that.isStackOffset_ &&
+               isNotStackOffset_ == that.isNotStackOffset_ &&
+               (!isStackOffset_ || stackOffset_ == that.stackOffset_) &&
+               isProduct_ == that.isProduct_ &&
+               isNotProduct_ == that.isNotProduct_ &&
+               isReturnAddress_ == that.isReturnAddress_ &&
+               isNotReturnAddress_ == that.isNotReturnAddress_;
+    }
+
+    /**
+     * \param that Another value.
+     *
+     * \return True if the values carry different information, false otherwise.
+     */
+    bool operator!=(const Value &that) const { return !(*this == that); }
 };
 
 } // namespace dflow
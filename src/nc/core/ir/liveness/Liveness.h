@@ -5,23 +5,21 @@
 
 #include <nc/config.h>
 
-#include <boost/unordered_set.hpp>
+#include <vector>
 
-#include <nc/common/Range.h>
+#include <nc/core/ir/DenseMap.h>
+#include <nc/core/ir/Term.h>
 
 namespace nc {
 namespace core {
 namespace ir {
-
-class Term;
-
 namespace liveness {
 
 /**
  * Set of terms producing actual high-level code.
  */
 class Liveness {
-    boost::unordered_set<const Term *> liveTermSet_; ///< The set of live terms.
+    DenseMap<Term, bool> liveTermSet_; ///< The set of live terms.
     std::vector<const Term *> liveTermList_; ///< The list of live terms.
 
 public:
@@ -32,7 +30,7 @@ public:
      */
     bool isLive(const Term *term) const {
         assert(term != nullptr);
-        return nc::contains(liveTermSet_, term);
+        return liveTermSet_.get(term);
     }
 
     /**
@@ -43,9 +41,11 @@ public:
     void makeLive(const Term *term) {
         assert(term != nullptr);
 
-        if (liveTermSet_.insert(term).second) {
+        auto &live = liveTermSet_[term];
+        if (!live) {
+            live = true;
             liveTermList_.push_back(term);
-        };
+        }
     }
 
     /**
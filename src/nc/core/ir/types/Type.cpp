@@ -24,12 +24,16 @@
 
 #include "Type.h"
 
+#include <algorithm>
 #include <cassert>
+#include <iterator>
 
 #include <QTextStream>
 
 #include <nc/common/Foreach.h>
 
+#include "Types.h"
+
 namespace nc {
 namespace core {
 namespace ir {
@@ -38,34 +42,34 @@ namespace types {
 void Type::updateSize(SmallBitSize size) {
     if (size && (!size_ || size < size_)) {
         size_ = size;
-        changed_ = true;
+        markChanged();
     }
 }
 
 void Type::makeInteger() {
     if (!isInteger_) {
         isInteger_ = true;
-        changed_ = true;
+        markChanged();
     }
 }
 
 void Type::makeFloat() {
     if (!isFloat_) {
         isFloat_ = true;
-        changed_ = true;
+        markChanged();
     }
 }
 
 void Type::makePointer(Type *pointee) {
     if (!isPointer_) {
         isPointer_ = true;
-        changed_ = true;
+        markChanged();
     }
 
     if (pointee) {
         if (!pointee_) {
             pointee_ = pointee;
-            changed_ = true;
+            markChanged();
         } else {
             pointee_->unionSet(pointee);
         }
@@ -75,14 +79,14 @@ void Type::makePointer(Type *pointee) {
 void Type::makeSigned() {
     if (!isSigned_) {
         isSigned_ = true;
-        changed_ = true;
+        markChanged();
     }
 }
 
 void Type::makeUnsigned() {
     if (!isUnsigned_) {
         isUnsigned_ = true;
-        changed_ = true;
+        markChanged();
     }
 }
 
@@ -105,7 +109,7 @@ void Type::updateFactor(ConstantValue increment) {
     factor_ = gcd(increment, factor_);
 
     if (oldFactor != factor_) {
-        changed_ = true;
+        markChanged();
     }
 }
 
@@ -129,16 +133,81 @@ bool Type::changed() {
     }
 }
 
+void Type::markChanged() {
+    changed_ = true;
+    log();
+}
+
+void Type::log() {
+    if (!logged_ && changeLog_) {
+        logged_ = true;
+        changeLog_->changedTypes_.push_back(this);
+    }
+}
+
+void Type::addFunction(const Function *function) {
+    auto &functions = findSet()->functions_;
+    auto i = std::lower_bound(functions.begin(), functions.end(), function);
+    if (i == functions.end() || *i != function) {
+        functions.insert(i, function);
+    }
+}
+
 void Type::unionSet(Type *that) {
     Type *thisSet = this->findSet();
     Type *thatSet = that->findSet();
 
+    if (thisSet == thatSet) {
+        return;
+    }
+
     DisjointSet<Type>::unionSet(that);
 
-    if (findSet() == thisSet) {
-        thisSet->join(thatSet);
-    } else {
-        thatSet->join(thisSet);
+    Type *set = findSet();
+    Type *other = set == thisSet ? thatSet : thisSet;
+
+    /*
+     * The users of the absorbed set now see the properties and the identity
+     * of the resulting set. The users of the resulting set see no change,
+     * unless joining changes its properties. Those using both sets are
+     * among the users of the absorbed one.
+     */
+    if (set->changeLog_) {
+        auto &affectedUsers = set->changeLog_->affectedUsers_;
+        affectedUsers.insert(affectedUsers.end(), other->users_.begin(), other->users_.end());
+    }
+
+    /*
+     * Move the users and functions before joining the properties: joining
+     * the pointees can merge the resulting set into yet another one.
+     * The shorter list of users is appended to the longer one.
+     */
+    if (set->users_.size() < other->users_.size()) {
+        set->users_.swap(other->users_);
+    }
+    set->users_.insert(set->users_.end(), other->users_.begin(), other->users_.end());
+    std::vector<const Term *>().swap(other->users_);
+
+    bool newFunctions = !std::includes(set->functions_.begin(), set->functions_.end(),
+                                       other->functions_.begin(), other->functions_.end());
+    if (newFunctions) {
+        std::vector<const Function *> functions;
+        functions.reserve(set->functions_.size() + other->functions_.size());
+        std::set_union(set->functions_.begin(), set->functions_.end(),
+                       other->functions_.begin(), other->functions_.end(), std::back_inserter(functions));
+        set->functions_.swap(functions);
+    }
+    std::vector<const Function *>().swap(other->functions_);
+
+    set->join(other);
+
+    /*
+     * Merging is not a change of the type's properties, so the changed flag
+     * is left as it is. The functions that got terms of this set must see
+     * the flag, though.
+     */
+    if (newFunctions && set->changed_) {
+        set->log();
     }
 }
 
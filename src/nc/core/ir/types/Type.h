@@ -25,6 +25,8 @@
 
 #include <nc/config.h>
 
+#include <vector>
+
 #ifdef NC_STRUCT_RECOVERY
 #include <map>
 #endif
@@ -36,9 +38,14 @@
 namespace nc {
 namespace core {
 namespace ir {
+
+class Function;
+class Term;
+
 namespace types {
 
 class Type;
+class Types;
 
 /**
  * Information about a type of a term.
@@ -63,15 +70,31 @@ class Type: public DisjointSet<Type>, public PrintableBase<Type> {
 
     bool changed_; ///< Type properties have changed since last call to changed().
 
+    Types *changeLog_; ///< Types whose change log this type is appended to when it changes. Can be nullptr.
+    bool logged_; ///< The type is in the change log.
+
+    std::vector<const Term *> users_; ///< Terms whose types are computed from this set. Valid only for representatives.
+
+    /** Sorted list of functions having terms of this set. Valid only for representatives. */
+    std::vector<const Function *> functions_;
+
+    friend class Types;
+
     public:
 
     /**
      * Class constructor.
+     *
+     * \param[in] changeLog Pointer to the types whose change log this type
+     *                      must be appended to when its properties change.
+     *                      The users of the sets merged into this one are
+     *                      logged there too. Can be nullptr.
      */
-    Type():
+    explicit Type(Types *changeLog = nullptr):
         size_(0),
         isInteger_(false), isFloat_(false), isPointer_(false), pointee_(0),
-        isSigned_(false), isUnsigned_(false), factor_(0), changed_(false)
+        isSigned_(false), isUnsigned_(false), factor_(0), changed_(false),
+        changeLog_(changeLog), logged_(false)
     { 
 #ifdef NC_STRUCT_RECOVERY
         addOffset(0, this); 
@@ -184,6 +207,36 @@ class Type: public DisjointSet<Type>, public PrintableBase<Type> {
      */
     bool changed();
 
+    /**
+     * \return True, if type properties have changed since last call to changed().
+     *         Unlike changed(), does not reset the flag.
+     */
+    bool hasChanged() const { return changed_; }
+
+    /**
+     * \return Terms whose types are computed from the types in this set.
+     */
+    const std::vector<const Term *> &users() const { return findSet()->users_; }
+
+    /**
+     * Registers a term whose type is computed from the types in this set.
+     *
+     * \param[in] term Valid pointer to the term.
+     */
+    void addUser(const Term *term) { findSet()->users_.push_back(term); }
+
+    /**
+     * Registers a function having terms of this set.
+     *
+     * \param[in] function Valid pointer to the function.
+     */
+    void addFunction(const Function *function);
+
+    /**
+     * \return Sorted list of functions registered as having terms of this set.
+     */
+    const std::vector<const Function *> &functions() const { return findSet()->functions_; }
+
     /**
      * Merges this and that types together.
      *
@@ -204,6 +257,18 @@ class Type: public DisjointSet<Type>, public PrintableBase<Type> {
      * \param out Output stream.
      */
     void print(QTextStream &out) const;
+
+    private:
+
+    /**
+     * Sets the changed flag and appends this type to the change log.
+     */
+    void markChanged();
+
+    /**
+     * Appends this type to the change log, unless it is already there.
+     */
+    void log();
 };
 
 } // namespace types
@@ -24,10 +24,13 @@
 
 #include "TypeAnalyzer.h"
 
+#include <boost/unordered_map.hpp>
+
 #include <nc/common/CancellationToken.h>
 #include <nc/common/Foreach.h>
 
 #include <nc/core/ir/BasicBlock.h>
+#include <nc/core/ir/DenseMap.h>
 #include <nc/core/ir/Function.h>
 #include <nc/core/ir/Functions.h>
 #include <nc/core/ir/Jump.h>
@@ -52,6 +55,20 @@ namespace core {
 namespace ir {
 namespace types {
 
+namespace {
+
+/**
+ * Live terms of a function and the state of their recomputation.
+ */
+struct FunctionTerms {
+    const std::vector<const Term *> *terms; ///< Live terms of the function, in the order of sweeps.
+    DenseMap<Term, std::size_t> positions; ///< Mapping from a live term to its index in the list.
+    std::vector<char> dirty; ///< Flags of the terms whose inputs changed since they were last recomputed.
+    std::vector<Type *> changedTypes; ///< Types of the function's terms that may have the changed flag set.
+};
+
+} // anonymous namespace
+
 void TypeAnalyzer::analyze() {
     uniteTypesOfAssignedTerms();
     uniteVariableTypes();
@@ -59,14 +76,112 @@ void TypeAnalyzer::analyze() {
     markStackPointersAsPointers();
 
     /*
-     * Recompute types until reaching fixpoint.
+     * Recompute types until reaching fixpoint, in the same order as
+     * repeated forward and backward sweeps over the live terms of each
+     * function would do. The rules for additions are order-dependent,
+     * so this order must be kept to get the same types.
+     *
+     * Recomputing a term whose type and operand types have not changed
+     * since it was last recomputed is a no-op, so such terms are skipped.
+     * Sweeps and the decisions whether to repeat them are made exactly
+     * as before.
      */
+    std::vector<FunctionTerms> functionTerms(functions_.list().size());
+    boost::unordered_map<const Function *, FunctionTerms *> function2terms;
+
+    std::size_t functionIndex = 0;
+    foreach (const Function *function, functions_.list()) {
+        auto &item = functionTerms[functionIndex++];
+        function2terms[function] = &item;
+
+        item.terms = &livenesses_.at(function)->liveTerms();
+        item.dirty.assign(item.terms->size(), true);
+
+        for (std::size_t i = 0; i < item.terms->size(); ++i) {
+            const Term *term = (*item.terms)[i];
+            item.positions[term] = i;
+            addUser(term);
+            types_.getType(term)->addFunction(function);
+        }
+        canceled_.poll();
+    }
+
+    std::vector<Type *> changedTypes;
+    std::vector<const Term *> affectedUsers;
+
+    auto takeChanges = [&]() {
+        auto makeDirty = [&](const Term *user) {
+            auto &item = *function2terms.at(user->statement()->basicBlock()->function());
+            item.dirty[*item.positions.find(user)] = true;
+        };
+
+        types_.takeChanges(changedTypes, affectedUsers);
+
+        foreach (Type *type, changedTypes) {
+            /* The users of a type merged into another set are among the affected ones. */
+            if (type->findSet() != type) {
+                continue;
+            }
+            foreach (const Term *user, type->users()) {
+                makeDirty(user);
+            }
+            if (type->hasChanged()) {
+                foreach (const Function *function, type->functions()) {
+                    function2terms.at(function)->changedTypes.push_back(type);
+                }
+            }
+        }
+        foreach (const Term *user, affectedUsers) {
+            makeDirty(user);
+        }
+    };
+
+    /* Everything is dirty anyway, but the changed flags must be distributed. */
+    takeChanges();
+
+    /*
+     * Equivalent of sweeping forward and then backward over all the
+     * live terms of the function and checking whether the types of any
+     * of them have changed.
+     */
+    auto analyzeFunction = [&](FunctionTerms &item) -> bool {
+        for (std::size_t i = 0; i < item.dirty.size(); ++i) {
+            if (item.dirty[i]) {
+                item.dirty[i] = false;
+                analyze((*item.terms)[i]);
+                takeChanges();
+            }
+        }
+        for (std::size_t i = item.dirty.size(); i-- > 0;) {
+            if (item.dirty[i]) {
+                item.dirty[i] = false;
+                analyze((*item.terms)[i]);
+                takeChanges();
+            }
+        }
+
+        /*
+         * A type that is no longer a representative was appended here
+         * before being merged. Its flag is not looked at, like before.
+         * Each representative with the flag set is appended to the lists
+         * of all functions having its terms.
+         */
+        bool changed = false;
+        foreach (Type *type, item.changedTypes) {
+            if (type->findSet() == type && type->changed()) {
+                changed = true;
+            }
+        }
+        item.changedTypes.clear();
+        return changed;
+    };
+
     bool changed;
     do {
         changed = false;
 
-        foreach (const Function *function, functions_.list()) {
-            while (analyze(function)) {
+        foreach (auto &item, functionTerms) {
+            while (analyzeFunction(item)) {
                 changed = true;
                 canceled_.poll();
             }
@@ -75,6 +190,30 @@ void TypeAnalyzer::analyze() {
     } while (changed);
 }
 
+void TypeAnalyzer::addUser(const Term *term) {
+    switch (term->kind()) {
+        case Term::INT_CONST: /* FALLTHROUGH */
+        case Term::INTRINSIC: /* FALLTHROUGH */
+        case Term::MEMORY_LOCATION_ACCESS:
+            return;
+        case Term::DEREFERENCE:
+            types_.getType(term->asDereference()->address())->addUser(term);
+            break;
+        case Term::UNARY_OPERATOR:
+            types_.getType(term->asUnaryOperator()->operand())->addUser(term);
+            break;
+        case Term::BINARY_OPERATOR:
+            types_.getType(term->asBinaryOperator()->left())->addUser(term);
+            types_.getType(term->asBinaryOperator()->right())->addUser(term);
+            break;
+        default:
+            unreachable();
+            break;
+    }
+
+    types_.getType(term)->addUser(term);
+}
+
 void TypeAnalyzer::uniteTypesOfAssignedTerms() {
     /*
      * Unite types of arguments of left and right hand sides of assignments.
@@ -162,29 +301,6 @@ void TypeAnalyzer::markStackPointersAsPointers() {
     }
 }
 
-bool TypeAnalyzer::analyze(const Function *function) {
-    const auto &liveness = *livenesses_.at(function);
-
-    /*
-     * Going in both directions makes the process
-     * converge much faster on some examples.
-     */
-    foreach (const Term *term, liveness.liveTerms()) {
-        analyze(term);
-    }
-    reverse_foreach (const Term *term, liveness.liveTerms()) {
-        analyze(term);
-    }
-
-    bool changed = false;
-    foreach (const Term *term, liveness.liveTerms()) {
-        if (types_.getType(term)->changed()) {
-            changed = true;
-        }
-    }
-    return changed;
-}
-
 void TypeAnalyzer::analyze(const Term *term) {
     switch (term->kind()) {
         case Term::INT_CONST: /* FALLTHROUGH */
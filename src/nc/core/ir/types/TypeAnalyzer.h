@@ -122,13 +122,13 @@ private:
     void markStackPointersAsPointers();
 
     /**
-     * Recomputes types of terms in the given function.
+     * Registers the term as a user of the types its type is computed from:
+     * the type of the term itself and the types of its operands.
+     * Does nothing if the type of the term is not computed from other types.
      *
-     * \param function Valid pointer to a function.
-     *
-     * \return True if types changed, false otherwise.
+     * \param term Valid pointer to a term.
      */
-    bool analyze(const Function *function);
+    void addUser(const Term *term);
 
     /**
      * Recomputes type of the given term.
@@ -24,6 +24,8 @@
 
 #include "Types.h"
 
+#include <nc/common/Foreach.h>
+
 #include <nc/core/ir/Term.h>
 
 #include "Type.h"
@@ -40,7 +42,7 @@ Types::~Types() {}
 Type *Types::getType(const Term *term) {
     auto &type = types_[term];
     if (!type) {
-        type.reset(new Type());
+        type.reset(new Type(this));
         type->updateSize(term->size());
         return type.get();
     } else {
@@ -52,6 +54,18 @@ const Type *Types::getType(const Term *term) const {
     return const_cast<Types *>(this)->getType(term);
 }
 
+void Types::takeChanges(std::vector<Type *> &types, std::vector<const Term *> &users) {
+    types.clear();
+    types.swap(changedTypes_);
+
+    foreach (Type *type, types) {
+        type->logged_ = false;
+    }
+
+    users.clear();
+    users.swap(affectedUsers_);
+}
+
 }}}} // namespace nc::core::ir::types
 
 /* vim:set et sts=4 sw=4: */
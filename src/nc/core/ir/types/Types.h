@@ -23,6 +23,9 @@
 
 #pragma once
 
+#include <memory>
+#include <vector>
+
 #include <boost/unordered_map.hpp>
 
 namespace nc {
@@ -40,6 +43,10 @@ class Type;
  */
 class Types {
     mutable boost::unordered_map<const Term *, std::unique_ptr<Type> > types_; ///< Mapping of terms to their type traits.
+    std::vector<Type *> changedTypes_; ///< Types changed since the last call to takeChanges().
+    std::vector<const Term *> affectedUsers_; ///< Users of the sets merged into other sets since the last call to takeChanges().
+
+    friend class Type;
 
     public:
 
@@ -71,6 +78,21 @@ class Types {
      * \return Mapping of terms to their type traits.
      */
     boost::unordered_map<const Term *, std::unique_ptr<Type> > &map() { return types_; };
+
+    /**
+     * Moves the types whose properties have changed since the last call to
+     * this function into the first list. The types that have absorbed sets
+     * of other functions while having the changed flag set are moved there
+     * too. The changed flags of the types are left intact. The types are not
+     * necessarily representatives of their sets.
+     *
+     * Moves the terms that used the sets merged into other sets since the
+     * last call to this function into the second list.
+     *
+     * \param[out] types List to store the types into. Its old contents are discarded.
+     * \param[out] users List to store the terms into. Its old contents are discarded.
+     */
+    void takeChanges(std::vector<Type *> &types, std::vector<const Term *> &users);
 };
 
 }}}} // namespace nc::core::ir::types
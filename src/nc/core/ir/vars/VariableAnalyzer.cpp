@@ -63,10 +63,7 @@ void VariableAnalyzer::analyze() {
         /*
          * Make a set for each read or write term which has a memory location.
          */
-        foreach (const auto &termAndLocation, dataflow.term2location()) {
-            const auto &term = termAndLocation.first;
-            const auto &location = termAndLocation.second;
-
+        dataflow.term2location().forEach([&](const Term *term, const MemoryLocation &location) {
             if ((term->isRead() || term->isWrite()) && location) {
                 if (architecture_->isGlobalMemory(location)) {
                     globalMemoryAccesses.push_back(Variable::TermAndLocation(term, location));
@@ -74,7 +71,7 @@ void VariableAnalyzer::analyze() {
                     term2set[term] = std::make_unique<TermSet>();
                 }
             }
-        }
+        });
 
         /*
          * Join sets of definitions and uses.
@@ -205,16 +205,28 @@ std::vector<ByteAddr> IRGenerator::getJumpTableEntries(const ir::Term *target, c
 
     auto byteOrder = image_->platform().architecture()->getByteOrder(ir::MemoryDomain::MEMORY);
 
+    /* Entries are read in batches; the table ends at the first entry not pointing to an instruction. */
+    const std::size_t batchSize = 256;
+    ByteAddr entries[batchSize];
+
     ByteAddr address = arrayAccess.base();
-    while (auto entry = reader.readInt<ByteAddr>(address, entrySize, byteOrder)) {
-        if (!isInstructionAddress(*entry)) {
-            break;
+    while (true) {
+        auto count = reader.readInts(address, entrySize, arrayAccess.stride(), batchSize, byteOrder, entries);
+
+        for (std::size_t i = 0; i < count; ++i) {
+            if (!isInstructionAddress(entries[i])) {
+                return result;
+            }
+            result.push_back(entries[i]);
+            address += arrayAccess.stride();
+
+            if (result.size() > maxTableEntries) {
+                log_.warning(tr("Jump table at address %1 seems to have more than %2 entries.").arg(address).arg(maxTableEntries));
+                return result;
+            }
         }
-        result.push_back(*entry);
-        address += arrayAccess.stride();
 
-        if (result.size() > maxTableEntries) {
-            log_.warning(tr("Jump table at address %1 seems to have more than %2 entries.").arg(address).arg(maxTableEntries));
+        if (count < batchSize) {
             break;
         }
     }
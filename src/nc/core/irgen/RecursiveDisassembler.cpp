@@ -0,0 +1,213 @@
+/* The file is part of Snowman decompiler. */
+/* See doc/licenses.asciidoc for the licensing information. */
+
+#include "RecursiveDisassembler.h"
+
+#include <cassert>
+
+#include <nc/common/Foreach.h>
+
+#include <nc/core/arch/Architecture.h>
+#include <nc/core/arch/Disassembler.h>
+#include <nc/core/arch/Instructions.h>
+#include <nc/core/image/Image.h>
+#include <nc/core/image/Relocation.h>
+#include <nc/core/image/Section.h>
+#include <nc/core/ir/Jump.h>
+#include <nc/core/ir/Program.h>
+#include <nc/core/ir/Statements.h>
+
+#include "IRGenerator.h"
+#include "InstructionAnalyzer.h"
+#include "InvalidInstructionException.h"
+
+namespace nc {
+namespace core {
+namespace irgen {
+
+RecursiveDisassembler::RecursiveDisassembler(const image::Image *image, const CancellationToken &canceled, const LogToken &log):
+    image_(image), canceled_(canceled), log_(log),
+    disassembler_(image->platform().architecture()->createDisassembler()),
+    instructionAnalyzer_(image->platform().architecture()->createInstructionAnalyzer())
+{
+    assert(image);
+}
+
+RecursiveDisassembler::~RecursiveDisassembler() {}
+
+std::vector<ByteAddr> RecursiveDisassembler::getEntryAddresses() const {
+    std::vector<ByteAddr> result;
+
+    auto isCodeAddress = [this](ByteAddr address) -> bool {
+        auto section = image_->getSectionContainingAddress(address);
+        return section && section->isCode();
+    };
+
+    if (image_->entrypoint()) {
+        result.push_back(*image_->entrypoint());
+    }
+
+    foreach (auto symbol, image_->symbols()) {
+        if (symbol->type() == image::SymbolType::FUNCTION && symbol->value() && isCodeAddress(*symbol->value())) {
+            result.push_back(*symbol->value());
+        }
+    }
+
+    foreach (auto relocation, image_->relocations()) {
+        if (relocation->symbol()->value()) {
+            ByteAddr target = *relocation->symbol()->value() + relocation->addend();
+            if (isCodeAddress(target)) {
+                result.push_back(target);
+            }
+        }
+    }
+
+    return result;
+}
+
+void RecursiveDisassembler::disassemble(std::vector<ByteAddr> addresses, arch::Instructions &instructions) {
+    /*
+     * Each round disassembles the sequences of instructions starting at
+     * the given addresses and generates the intermediate representation
+     * of them, which reveals the targets of jumps and calls (including
+     * jump tables) to be disassembled in the next round.
+     */
+    while (!addresses.empty()) {
+        arch::Instructions found;
+
+        {
+            /*
+             * Statements of the instructions found in this round, created
+             * only to tell where the sequences end. They are generated
+             * into one program, not into a new program per instruction.
+             */
+            ir::Program sequences;
+
+            foreach (ByteAddr address, addresses) {
+                disassembleSequence(address, instructions, found, sequences);
+                canceled_.poll();
+            }
+        }
+
+        if (found.empty()) {
+            break;
+        }
+
+        ir::Program program;
+        IRGenerator(image_, &found, &program, canceled_, log_).generate();
+
+        foreach (const auto &instruction, found.all()) {
+            instructions.add(instruction);
+        }
+
+        addresses.clear();
+        getTargetAddresses(program, instructions, addresses);
+    }
+}
+
+void RecursiveDisassembler::disassembleSequence(ByteAddr address, const arch::Instructions &known, arch::Instructions &found,
+                                                ir::Program &program) {
+    ByteAddr pc = address;
+
+    while (true) {
+        /* Do not decode overlapping instructions. */
+        if (known.getCovering(pc) || found.getCovering(pc)) {
+            break;
+        }
+
+        /* Relocated bytes are data. */
+        if (image_->getRelocation(pc)) {
+            break;
+        }
+
+        auto section = image_->getSectionContainingAddress(pc);
+        if (!section || !section->isCode()) {
+            break;
+        }
+
+        auto instruction = disassembler_->disassembleSingleInstruction(pc, section);
+        if (!instruction) {
+            break;
+        }
+
+        bool next = fallsThrough(instruction.get(), program);
+
+        pc = instruction->endAddr();
+        found.add(std::move(instruction));
+
+        if (!next) {
+            break;
+        }
+    }
+}
+
+bool RecursiveDisassembler::fallsThrough(const arch::Instruction *instruction, ir::Program &program) {
+    assert(instruction != nullptr);
+
+    try {
+        instructionAnalyzer_->createStatements(instruction, &program);
+    } catch (const InvalidInstructionException &) {
+        /* The generation of the intermediate representation will report it. */
+        return true;
+    }
+
+    auto basicBlock = program.getBasicBlockCovering(instruction->addr());
+    if (!basicBlock) {
+        return true;
+    }
+
+    /*
+     * The instruction's statements are appended to the basic block
+     * of the preceding instruction, if there is one. The terminator
+     * may then belong to that instruction, e.g. if this one generates
+     * no statements.
+     */
+    auto terminator = basicBlock->getTerminator();
+    if (!terminator || terminator->instruction() != instruction) {
+        return true;
+    }
+
+    if (terminator->is<ir::Halt>()) {
+        return false;
+    }
+
+    return terminator->as<ir::Jump>()->isConditional();
+}
+
+void RecursiveDisassembler::getTargetAddresses(const ir::Program &program, const arch::Instructions &instructions, std::vector<ByteAddr> &addresses) const {
+    auto addTarget = [&](ByteAddr address) {
+        if (!instructions.get(address)) {
+            addresses.push_back(address);
+        }
+    };
+
+    auto addJumpTarget = [&](const ir::JumpTarget &target) {
+        if (target.basicBlock() && target.basicBlock()->address()) {
+            addTarget(*target.basicBlock()->address());
+        }
+        if (target.table()) {
+            foreach (const auto &entry, *target.table()) {
+                addTarget(entry.address());
+            }
+        }
+    };
+
+    foreach (auto basicBlock, program.basicBlocks()) {
+        foreach (auto statement, basicBlock->statements()) {
+            if (auto jump = statement->as<ir::Jump>()) {
+                addJumpTarget(jump->thenTarget());
+                addJumpTarget(jump->elseTarget());
+            }
+        }
+    }
+
+    foreach (ByteAddr address, program.calledAddresses()) {
+        addTarget(address);
+    }
+}
+
+} // namespace irgen
+} // namespace core
+} // namespace nc
+
+/* vim:set et sts=4 sw=4: */
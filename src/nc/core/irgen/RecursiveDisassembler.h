@@ -0,0 +1,122 @@
+/* The file is part of Snowman decompiler. */
+/* See doc/licenses.asciidoc for the licensing information. */
+
+#pragma once
+
+#include <nc/config.h>
+
+#include <QCoreApplication>
+
+#include <memory>
+#include <vector>
+
+#include <nc/common/CancellationToken.h>
+#include <nc/common/LogToken.h>
+#include <nc/common/Types.h>
+
+namespace nc {
+namespace core {
+
+namespace image {
+    class Image;
+}
+
+namespace ir {
+    class Program;
+}
+
+namespace arch {
+    class Disassembler;
+    class Instruction;
+    class Instructions;
+}
+
+namespace irgen {
+
+class InstructionAnalyzer;
+
+/**
+ * Disassembler decoding only the code reachable from given addresses
+ * by following the control flow: fall-through edges, direct jumps
+ * and calls, and jump tables.
+ */
+class RecursiveDisassembler {
+    Q_DECLARE_TR_FUNCTIONS(RecursiveDisassembler)
+
+    const image::Image *image_; ///< Executable image.
+    const CancellationToken &canceled_; ///< Cancellation token.
+    const LogToken &log_; ///< Log token.
+    std::unique_ptr<arch::Disassembler> disassembler_; ///< Disassembler.
+    std::unique_ptr<InstructionAnalyzer> instructionAnalyzer_; ///< Instruction analyzer.
+
+public:
+    /**
+     * Constructor.
+     *
+     * \param[in] image Valid pointer to the executable image.
+     * \param[in] canceled Cancellation token.
+     * \param[in] log Log token.
+     */
+    RecursiveDisassembler(const image::Image *image, const CancellationToken &canceled, const LogToken &log);
+
+    /**
+     * Destructor.
+     */
+    ~RecursiveDisassembler();
+
+    /**
+     * \return Addresses known to contain code: the entry point, the values
+     *         of function symbols, and the targets of relocations pointing
+     *         to code sections.
+     */
+    std::vector<ByteAddr> getEntryAddresses() const;
+
+    /**
+     * Disassembles the code reachable from the given addresses.
+     * The instructions already present in the set are not disassembled again.
+     *
+     * \param[in] addresses Addresses to start from.
+     * \param[in,out] instructions Set of instructions to add the disassembled instructions to.
+     */
+    void disassemble(std::vector<ByteAddr> addresses, arch::Instructions &instructions);
+
+private:
+    /**
+     * Disassembles instructions one after another, starting from the given address,
+     * until an instruction not passing control to the next one, an address that
+     * is not in a code section, or an already disassembled instruction is met.
+     *
+     * \param[in] address Address to start from.
+     * \param[in] known Instructions disassembled before.
+     * \param[in,out] found Instructions disassembled in this round.
+     * \param[in,out] program Program receiving the statements of the instructions disassembled in this round.
+     */
+    void disassembleSequence(ByteAddr address, const arch::Instructions &known, arch::Instructions &found,
+                             ir::Program &program);
+
+    /**
+     * Generates the statements of an instruction and checks whether it can pass
+     * control to the instruction following it.
+     *
+     * \param[in] instruction Valid pointer to an instruction.
+     * \param[in,out] program Program to generate the statements into.
+     *
+     * \return True if the instruction may pass control to the instruction following it, false otherwise.
+     */
+    bool fallsThrough(const arch::Instruction *instruction, ir::Program &program);
+
+    /**
+     * Collects the addresses of the jump and call targets in the program.
+     *
+     * \param[in] program Program generated from the instructions.
+     * \param[in] instructions Instructions disassembled so far.
+     * \param[out] addresses Addresses not disassembled yet.
+     */
+    void getTargetAddresses(const ir::Program &program, const arch::Instructions &instructions, std::vector<ByteAddr> &addresses) const;
+};
+
+} // namespace irgen
+} // namespace core
+} // namespace nc
+
+/* vim:set et sts=4 sw=4: */
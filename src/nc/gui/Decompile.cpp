@@ -52,6 +52,7 @@ void Decompile::work() {
     context->setInstructions(instructions_);
     context->setCancellationToken(cancellationToken());
     context->setLogToken(project_->logToken());
+    context->setThreadCount(project_->threadCount());
 
     project_->setContext(context);
 
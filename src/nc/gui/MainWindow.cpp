@@ -24,10 +24,13 @@
 
 #include "MainWindow.h"
 
+#include <algorithm>
+
 #include <QAction>
 #include <QApplication>
 #include <QFileDialog>
 #include <QFileInfo>
+#include <QInputDialog>
 #include <QLabel>
 #include <QMenu>
 #include <QMenuBar>
@@ -42,6 +45,7 @@
 #include <nc/common/Branding.h>
 #include <nc/common/Exception.h>
 #include <nc/common/Foreach.h>
+#include <nc/common/Parallel.h>
 #include <nc/common/SignalLogger.h>
 #include <nc/common/make_unique.h>
 
@@ -72,7 +76,7 @@
 namespace nc { namespace gui {
 
 MainWindow::MainWindow(Branding branding, QWidget *parent):
-    QMainWindow(parent), branding_(std::move(branding))
+    QMainWindow(parent), branding_(std::move(branding)), threadCount_(1)
 {
     setDockNestingEnabled(true);
     setTabPosition(Qt::AllDockWidgetAreas, QTabWidget::North);
@@ -201,6 +205,9 @@ void MainWindow::createActions() {
     decompileAutomaticallyAction_->setCheckable(true);
     connect(decompileAutomaticallyAction_, SIGNAL(toggled(bool)), this, SLOT(setDecompileAutomatically(bool)));
 
+    chooseThreadCountAction_ = new QAction(tr("Analysis &Threads..."), this);
+    connect(chooseThreadCountAction_, SIGNAL(triggered()), this, SLOT(chooseThreadCount()));
+
     instructionsViewAction_ = instructionsView_->toggleViewAction();
     instructionsViewAction_->setText(tr("&Instructions"));
     instructionsViewAction_->setShortcut(Qt::ALT + Qt::Key_I);
@@ -255,6 +262,7 @@ void MainWindow::createMenus() {
     analyseMenu->addSeparator();
     analyseMenu->addAction(decompileAction_);
     analyseMenu->addAction(decompileAutomaticallyAction_);
+    analyseMenu->addAction(chooseThreadCountAction_);
     analyseMenu->addSeparator();
     analyseMenu->addAction(cancelAllAction_);
 
@@ -282,6 +290,7 @@ void MainWindow::loadSettings() {
     }
     restoreState(settings_->value("windowState", saveState()).toByteArray());
     setDecompileAutomatically(settings_->value("decompileAutomatically", true).toBool());
+    setThreadCount(settings_->value("threadCount", idealThreadCount()).toInt());
 
     foreach (QObject *child, children()) {
         if (auto textView = qobject_cast<TextView *>(child)) {
@@ -303,6 +312,7 @@ void MainWindow::saveSettings() {
     }
     settings_->setValue("windowState", saveState());
     settings_->setValue("decompileAutomatically", decompileAutomatically());
+    settings_->setValue("threadCount", threadCount());
 
     foreach (QObject *child, children()) {
         if (auto textView = qobject_cast<TextView *>(child)) {
@@ -404,6 +414,8 @@ void MainWindow::open(std::unique_ptr<Project> project) {
     /* Log messages to the log window. */
     project_->setLogToken(logToken_);
 
+    project_->setThreadCount(threadCount_);
+
     /* Connect the project to the slots for updating views. */
     connect(project_.get(), SIGNAL(nameChanged()), this, SLOT(updateGuiState()));
     connect(project_.get(), SIGNAL(imageChanged()), this, SLOT(imageChanged()));
@@ -604,6 +616,23 @@ void MainWindow::setDecompileAutomatically(bool value) {
     decompileAutomaticallyAction_->setChecked(value);
 }
 
+void MainWindow::setThreadCount(int count) {
+    threadCount_ = std::max(count, 1);
+
+    if (project()) {
+        project()->setThreadCount(threadCount_);
+    }
+}
+
+void MainWindow::chooseThreadCount() {
+    bool ok;
+    int count = QInputDialog::getInt(this, tr("Analysis Threads"), tr("Maximal number of threads used by analyses:"),
+                                     threadCount(), 1, 1024, 1, &ok);
+    if (ok) {
+        setThreadCount(count);
+    }
+}
+
 void MainWindow::highlightInstructionsInCxx() {
     if (cxxView_->isVisible()) {
         /* Block signals, in order to avoid backfire. */
@@ -85,6 +85,7 @@ class MainWindow: public QMainWindow {
     QAction *decompileAction_; ///< Action for starting decompilation.
     QAction *cancelAllAction_; ///< Action for cancelling all scheduled commands.
     QAction *decompileAutomaticallyAction_; ///< Action for toggling automatic decompilation.
+    QAction *chooseThreadCountAction_; ///< Action for choosing the number of analysis threads.
     QAction *instructionsViewAction_; ///< Action for showing/hiding the instructions window.
     QAction *sectionsViewAction_; ///< Action for showing/hiding the sections window.
     QAction *symbolsViewAction_; ///< Action for showing/hiding the symbols window.
@@ -103,6 +104,8 @@ class MainWindow: public QMainWindow {
 
     LogToken logToken_; ///< Log token.
 
+    int threadCount_; ///< Maximal number of threads used by analyses.
+
 public:
     /**
      * Constructor.
@@ -148,6 +151,11 @@ public:
      */
     bool decompileAutomatically() const;
 
+    /**
+     * \return Maximal number of threads used by analyses.
+     */
+    int threadCount() const { return threadCount_; }
+
 public Q_SLOTS:
     /**
      * Sets whether decompilation must be performed when a user changes the project.
@@ -156,6 +164,14 @@ public Q_SLOTS:
      */
     void setDecompileAutomatically(bool value);
 
+    /**
+     * Sets the maximal number of threads used by analyses.
+     * Takes effect starting from the next decompilation.
+     *
+     * \param count Number of threads.
+     */
+    void setThreadCount(int count);
+
     /**
      * Opens a dialog for selecting files for decompilation, parses selected files, and starts decompiling them.
      */
@@ -320,6 +336,11 @@ private Q_SLOTS:
      */
     void decompile();
 
+    /**
+     * Asks the user for the number of analysis threads.
+     */
+    void chooseThreadCount();
+
     /**
      * Opens the disassembly dialog with the currently selected section chosen.
      */
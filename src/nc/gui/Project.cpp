@@ -48,6 +48,7 @@ Project::Project(QObject *parent):
     image_(std::make_shared<core::image::Image>()),
     instructions_(std::make_shared<core::arch::Instructions>()),
     context_(std::make_shared<core::Context>()),
+    threadCount_(1),
     commandQueue_(new CommandQueue(this))
 {
 }
@@ -76,6 +76,9 @@ class Project: public QObject {
     /** Log token. */
     LogToken logToken_;
 
+    /** Maximal number of threads used by analyses. */
+    int threadCount_;
+
     /** Queue of user commands. */
     CommandQueue *commandQueue_;
 
@@ -153,6 +156,18 @@ class Project: public QObject {
      */
     const LogToken &logToken() const { return logToken_; }
 
+    /**
+     * Sets the maximal number of threads used by analyses.
+     *
+     * \param count Number of threads.
+     */
+    void setThreadCount(int count) { threadCount_ = count; }
+
+    /**
+     * \return Maximal number of threads used by analyses.
+     */
+    int threadCount() const { return threadCount_; }
+
     /*
      * \return Valid pointer to command queue.
      */
@@ -33,6 +33,8 @@
 #include <nc/common/make_unique.h>
 
 #include <nc/core/image/Image.h>
+#include <nc/core/image/MappedByteSource.h>
+#include <nc/core/image/MappedFile.h>
 #include <nc/core/image/Reader.h>
 #include <nc/core/image/Relocation.h>
 #include <nc/core/image/Section.h>
@@ -109,6 +111,7 @@ class ElfParserImpl {
     QIODevice *source_;
     core::image::Image *image_;
     const LogToken &log_;
+    std::shared_ptr<core::image::MappedFile> mappedFile_;
 
     typename Elf::Ehdr ehdr_;
     ByteOrder byteOrder_;
@@ -119,7 +122,8 @@ class ElfParserImpl {
 
 public:
     ElfParserImpl(QIODevice *source, core::image::Image *image, const LogToken &log):
-        source_(source), image_(image), log_(log), byteOrder_(ByteOrder::Current)
+        source_(source), image_(image), log_(log),
+        mappedFile_(core::image::MappedFile::map(source)), byteOrder_(ByteOrder::Current)
     {}
 
     void parse() {
@@ -229,7 +233,10 @@ private:
             section->setData(section->isAllocated() && !section->isCode() && !section->isBss());
 
             if (!section->isBss()) {
-                if (source_->seek(shdr.sh_offset)) {
+                if (mappedFile_ && mappedFile_->contains(shdr.sh_offset, shdr.sh_size)) {
+                    section->setExternalByteSource(std::make_unique<core::image::MappedByteSource>(
+                        mappedFile_, section->addr(), shdr.sh_offset, shdr.sh_size));
+                } else if (source_->seek(shdr.sh_offset)) {
                     auto bytes = source_->read(shdr.sh_size);
 
                     if (bytes.size() != static_cast<int>(shdr.sh_size)) {
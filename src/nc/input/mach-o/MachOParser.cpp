@@ -13,6 +13,8 @@
 #include <nc/common/make_unique.h>
 #include <nc/common/Range.h>
 #include <nc/core/image/Image.h>
+#include <nc/core/image/MappedByteSource.h>
+#include <nc/core/image/MappedFile.h>
 #include <nc/core/image/Section.h>
 #include <nc/core/input/ParseError.h>
 #include <nc/core/input/Utils.h>
@@ -77,6 +79,7 @@ class MachOParserImpl {
     QIODevice *source_;
     core::image::Image *image_;
     const LogToken &log_;
+    std::shared_ptr<core::image::MappedFile> mappedFile_;
 
     ByteOrder byteOrder_;
     boost::unordered_map<const core::image::Section *, uint64_t> section2foff_;
@@ -86,7 +89,8 @@ class MachOParserImpl {
 
 public:
     MachOParserImpl(QIODevice *source, core::image::Image *image, const LogToken &log):
-        source_(source), image_(image), log_(log), byteOrder_(ByteOrder::Current)
+        source_(source), image_(image), log_(log),
+        mappedFile_(core::image::MappedFile::map(source)), byteOrder_(ByteOrder::Current)
     {}
 
     template<class Mach>
@@ -253,7 +257,10 @@ private:
         imageSection->setData(!imageSection->isCode());
         imageSection->setBss((section.flags & SECTION_TYPE) == S_ZEROFILL);
 
-        if (!imageSection->isBss()) {
+        if (!imageSection->isBss() && mappedFile_ && mappedFile_->contains(section.offset, section.size)) {
+            imageSection->setExternalByteSource(std::make_unique<core::image::MappedByteSource>(
+                mappedFile_, imageSection->addr(), section.offset, section.size));
+        } else if (!imageSection->isBss()) {
             auto pos = source_->pos();
             if (!source_->seek(section.offset)) {
                 throw ParseError("Could not seek to the beginning of the section's content.");
@@ -35,6 +35,8 @@
 #include <nc/common/make_unique.h>
 
 #include <nc/core/image/Image.h>
+#include <nc/core/image/MappedByteSource.h>
+#include <nc/core/image/MappedFile.h>
 #include <nc/core/image/Reader.h>
 #include <nc/core/image/Relocation.h>
 #include <nc/core/image/Section.h>
@@ -112,6 +114,7 @@ class PeParserImpl {
     QIODevice *source_;
     core::image::Image *image_;
     const LogToken &log_;
+    std::shared_ptr<core::image::MappedFile> mappedFile_;
 
     ByteAddr optionalHeaderOffset_;
     IMAGE_FILE_HEADER &fileHeader_;
@@ -119,7 +122,8 @@ class PeParserImpl {
 
 public:
     PeParserImpl(QIODevice *source, core::image::Image *image, const LogToken &log, IMAGE_FILE_HEADER &fileHeader):
-        source_(source), image_(image), log_(log), fileHeader_(fileHeader)
+        source_(source), image_(image), log_(log),
+        mappedFile_(core::image::MappedFile::map(source)), fileHeader_(fileHeader)
     {}
 
     void parse() {
@@ -203,24 +207,29 @@ private:
             } else {
                 log_.debug(tr("Reading contents of section %1 (size of raw data = 0x%2).").arg(section->name()).arg(sectionHeader.SizeOfRawData));
 
-                QByteArray bytes;
-
-                auto pos = source_->pos();
-                if (source_->seek(sectionHeader.PointerToRawData)) {
-                    bytes = source_->read(sectionHeader.SizeOfRawData);
+                if (mappedFile_ && mappedFile_->contains(sectionHeader.PointerToRawData, sectionHeader.SizeOfRawData)) {
+                    section->setExternalByteSource(std::make_unique<core::image::MappedByteSource>(
+                        mappedFile_, section->addr(), sectionHeader.PointerToRawData, sectionHeader.SizeOfRawData));
                 } else {
-                    log_.warning(tr("Could not seek to the data of section %1.").arg(section->name()));
-                }
-                source_->seek(pos);
+                    QByteArray bytes;
 
-                if (static_cast<DWORD>(bytes.size()) != sectionHeader.SizeOfRawData) {
-                    log_.warning(tr("Could read only 0x%1 bytes of section %2, although its raw size is 0x%3.")
-                                     .arg(bytes.size(), 0, 16)
-                                     .arg(section->name())
-                                     .arg(sectionHeader.SizeOfRawData));
-                }
+                    auto pos = source_->pos();
+                    if (source_->seek(sectionHeader.PointerToRawData)) {
+                        bytes = source_->read(sectionHeader.SizeOfRawData);
+                    } else {
+                        log_.warning(tr("Could not seek to the data of section %1.").arg(section->name()));
+                    }
+                    source_->seek(pos);
 
-                section->setContent(std::move(bytes));
+                    if (static_cast<DWORD>(bytes.size()) != sectionHeader.SizeOfRawData) {
+                        log_.warning(tr("Could read only 0x%1 bytes of section %2, although its raw size is 0x%3.")
+                                         .arg(bytes.size(), 0, 16)
+                                         .arg(section->name())
+                                         .arg(sectionHeader.SizeOfRawData));
+                    }
+
+                    section->setContent(std::move(bytes));
+                }
             }
 
             image_->addSection(std::move(section));
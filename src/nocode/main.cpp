@@ -27,11 +27,15 @@
 #include <nc/common/Branding.h>
 #include <nc/common/Exception.h>
 #include <nc/common/Foreach.h>
+#include <nc/common/Parallel.h>
 #include <nc/common/StreamLogger.h>
+#include <nc/common/StringToInt.h>
 #include <nc/common/Unreachable.h>
+#include <nc/common/make_unique.h>
 
 #include <nc/core/Context.h>
 #include <nc/core/Driver.h>
+#include <nc/core/Statistics.h>
 #include <nc/core/arch/Architecture.h>
 #include <nc/core/arch/ArchitectureRepository.h>
 #include <nc/core/arch/Instruction.h>
@@ -137,6 +141,12 @@ void help() {
          << "Options:" << endl
          << "  --help, -h                  Produce this help message and quit." << endl
          << "  --verbose, -v               Print progress information to stderr." << endl
+         << "  --threads[=N]               Use N threads (default: 1; without N: number of cores)." << endl
+         << "  --recursive                 Disassemble only the code reachable from the entry point and symbols." << endl
+         << "  --stats[=FILE]              Print time and memory spent in decompilation stages in JSON to the file." << endl
+         << "                              If it is stdout, C++ code is printed only when --print-cxx is given." << endl
+         << "  --trace=FILE                Write a timeline of decompilation stages in Chrome trace event format to the file." << endl
+         << "                              If it is stdout, C++ code is printed only when --print-cxx is given." << endl
          << "  --print-sections[=FILE]     Print information about sections of the executable file." << endl
          << "  --print-symbols[=FILE]      Print the symbols from the executable file." << endl
          << "  --print-instructions[=FILE] Print parsed instructions to the file." << endl
@@ -178,9 +188,13 @@ int main(int argc, char *argv[]) {
         QString irFile;
         QString regionsFile;
         QString cxxFile;
+        QString statsFile;
+        QString traceFile;
 
         bool autoDefault = true;
         bool verbose = false;
+        int threadCount = 1;
+        bool recursive = false;
 
         std::vector<nc::ByteAddr> functionAddresses;
         std::vector<nc::ByteAddr> callAddresses;
@@ -196,6 +210,22 @@ int main(int argc, char *argv[]) {
                 return 1;
             } else if (arg == "--verbose" || arg == "-v") {
                 verbose = true;
+            } else if (arg == "--threads") {
+                threadCount = nc::idealThreadCount();
+            } else if (arg.startsWith("--threads=")) {
+                auto count = nc::stringToInt<int>(arg.section('=', 1));
+                if (!count || *count < 1) {
+                    throw nc::Exception(QString("invalid number of threads: %1").arg(arg.section('=', 1)));
+                }
+                threadCount = *count;
+            } else if (arg == "--recursive") {
+                recursive = true;
+            } else if (arg == "--stats") {
+                statsFile = "-";
+            } else if (arg.startsWith("--stats=")) {
+                statsFile = arg.section('=', 1);
+            } else if (arg.startsWith("--trace=")) {
+                traceFile = arg.section('=', 1);
 
             #define FILE_OPTION(option, variable)       \
             } else if (arg == option) {                 \
@@ -226,8 +256,22 @@ int main(int argc, char *argv[]) {
             }
         }
 
+        if (statsFile == "-" && traceFile == "-") {
+            throw nc::Exception("--stats and --trace cannot both write to stdout");
+        }
+
+        /*
+         * By default, decompile and print C++ code to stdout.
+         * If stdout is taken by the statistics or the trace, still
+         * decompile, but do not mix the code into the JSON.
+         */
+        bool decompileAll = false;
         if (autoDefault) {
-            cxxFile = "-";
+            if (statsFile == "-" || traceFile == "-") {
+                decompileAll = true;
+            } else {
+                cxxFile = "-";
+            }
         }
 
         if (files.empty()) {
@@ -235,6 +279,11 @@ int main(int argc, char *argv[]) {
         }
 
         nc::core::Context context;
+        context.setThreadCount(threadCount);
+
+        if (!statsFile.isEmpty() || !traceFile.isEmpty()) {
+            context.setStatistics(std::make_unique<nc::core::Statistics>());
+        }
 
         if (verbose) {
             context.setLogToken(nc::LogToken(std::make_shared<nc::StreamLogger>(qerr)));
@@ -253,11 +302,15 @@ int main(int argc, char *argv[]) {
         openFileForWritingAndCall(sectionsFile, [&](QTextStream &out) { printSections(context, out); });
         openFileForWritingAndCall(symbolsFile, [&](QTextStream &out) { printSymbols(context, out); });
 
-        if (!instructionsFile.isEmpty() || !cfgFile.isEmpty() || !irFile.isEmpty() || !regionsFile.isEmpty() || !cxxFile.isEmpty()) {
-            nc::core::Driver::disassemble(context);
+        if (decompileAll || !instructionsFile.isEmpty() || !cfgFile.isEmpty() || !irFile.isEmpty() || !regionsFile.isEmpty() || !cxxFile.isEmpty()) {
+            if (recursive) {
+                nc::core::Driver::disassembleReachable(context);
+            } else {
+                nc::core::Driver::disassemble(context);
+            }
             openFileForWritingAndCall(instructionsFile, [&](QTextStream &out) { context.instructions()->print(out); });
 
-            if (!cfgFile.isEmpty() || !irFile.isEmpty() || !regionsFile.isEmpty() || !cxxFile.isEmpty()) {
+            if (decompileAll || !cfgFile.isEmpty() || !irFile.isEmpty() || !regionsFile.isEmpty() || !cxxFile.isEmpty()) {
                 nc::core::Driver::decompile(context);
 
                 openFileForWritingAndCall(cfgFile,     [&](QTextStream &out) { context.program()->print(out); });
@@ -266,6 +319,9 @@ int main(int argc, char *argv[]) {
                 openFileForWritingAndCall(cxxFile,     [&](QTextStream &out) { context.tree()->print(out); });
             }
         }
+
+        openFileForWritingAndCall(statsFile, [&](QTextStream &out) { context.statistics()->print(out); });
+        openFileForWritingAndCall(traceFile, [&](QTextStream &out) { context.statistics()->printTrace(out); });
     } catch (const nc::Exception &e) {
         qerr << self << ": " << e.unicodeWhat() << endl;
         return 1;